@@ -74,8 +74,26 @@ HEADERS += \
            modelmanager.h \
            modelparameter.h \
            modelselect.h \
+           modelcurvesolver.h \
            modelsolver01-06.h \
            modelsolver19_36.h \
+           modelsolverparams.h \
+           curvesensitivity.h \
+           laplaceinterpolator.h \
+           laplaceinversion.h \
+           dimensionlesscurvecache.h \
+           bemworkspace.h \
+           borderedsolver.h \
+           hmatrixbem.h \
+           farfieldquadrature.h \
+           bemasymptotes.h \
+           modeltraits.h \
+           compositekernel.h \
+           modelkernelregistry.h \
+           taskscheduler.h \
+           stehfesttable.h \
+           specialfunctions.h \
+           gausskronrod.h \
            mousezoom.h \
            newprojectdialog.h \
            paramselectdialog.h \
@@ -158,8 +176,19 @@ SOURCES += \
            modelmanager.cpp \
            modelparameter.cpp \
            modelselect.cpp \
+           modelcurvesolver.cpp \
            modelsolver01-06.cpp \
            modelsolver19_36.cpp \
+           modelsolverparams.cpp \
+           curvesensitivity.cpp \
+           laplaceinterpolator.cpp \
+           laplaceinversion.cpp \
+           dimensionlesscurvecache.cpp \
+           bemasymptotes.cpp \
+           bemworkspace.cpp \
+           modelkernelregistry.cpp \
+           taskscheduler.cpp \
+           specialfunctions.cpp \
            mousezoom.cpp \
            newprojectdialog.cpp \
            paramselectdialog.cpp \
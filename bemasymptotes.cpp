@@ -0,0 +1,106 @@
+/*
+ * 文件名: bemasymptotes.cpp
+ * 文件作用: 边界元渐近解几何标量的计算
+ * 功能描述:
+ * 1. 对数核 L_ij = -∫ln r、二阶核 P2_ij = ∫r²、Q2_ij = ∫r²·ln r 沿源段的积分均有闭式原函数，无需数值积分。
+ * 2. 对称矩阵 L 做一次部分主元 LU 分解得 u0 = L⁻¹1，再求 s0、p2、q2 及二阶摄动用的 a11、a12、a22。
+ * 3. 结果只依赖裂缝段布置，由边界元工作区按几何缓存。
+ * 4. 区间判据标量 (Dmax 等) 与晚期标量分开计算，稠密矩阵只在首次进入晚期区间时组装与分解。
+ */
+
+#include "bemasymptotes.h"
+#include "bemworkspace.h"
+
+#include <Eigen/Dense>
+#include <algorithm>
+
+namespace {
+
+// 沿直线 u 方向、与源点横向距离 d 的原函数 (d >= 0; d = 0 时对数奇异点可积)
+struct LineAntiderivative
+{
+    double lnInt;   // ∫ ln ρ du
+    double r2Int;   // ∫ ρ² du
+    double r2lnInt; // ∫ ρ²·ln ρ du
+};
+
+LineAntiderivative lineAntiderivative(double d, double u)
+{
+    LineAntiderivative f;
+    double rho2 = d * d + u * u;
+    double lnRho = (rho2 > 0.0) ? 0.5 * std::log(rho2) : 0.0;
+    double atanTerm = (d > 0.0) ? std::atan(u / d) : 0.0;
+    double u3 = u * u * u;
+
+    // ∫ln ρ du = u·ln ρ - u + d·atan(u/d)
+    f.lnInt = u * lnRho - u + d * atanTerm;
+    // ∫ρ² du = d²u + u³/3
+    f.r2Int = d * d * u + u3 / 3.0;
+    // ∫u²·ln ρ du = (u³/3)ln ρ - (1/3)[u³/3 - d²u + d³·atan(u/d)]
+    double u2lnInt = u3 / 3.0 * lnRho - (u3 / 3.0 - d * d * u + d * d * d * atanTerm) / 3.0;
+    f.r2lnInt = d * d * f.lnInt + u2lnInt;
+    return f;
+}
+
+} // namespace
+
+void BemAsymptotes::computeBounds(BemAsymptoteGeometry& geo, const QVector<Point2D>& centers,
+                                  int nf, double segLen, double spacingD)
+{
+    const int n = centers.size();
+    geo = BemAsymptoteGeometry();
+    geo.n = n;
+    geo.nf = nf;
+    geo.h = 0.5 * segLen;
+    geo.spacingD = spacingD;
+    if (n == 0) return;
+
+    // 最大距离: 两端裂缝的相对端点
+    double xMin = centers[0].x, xMax = centers[0].x, yMin = centers[0].y, yMax = centers[0].y;
+    for (const Point2D& c : centers) {
+        xMin = std::min(xMin, c.x); xMax = std::max(xMax, c.x);
+        yMin = std::min(yMin, c.y); yMax = std::max(yMax, c.y);
+    }
+    double w = xMax - xMin;
+    double l = (yMax - yMin) + segLen;
+    geo.dMax = std::sqrt(w * w + l * l);
+}
+
+void BemAsymptotes::computeLateGeometry(BemAsymptoteGeometry& geo, const QVector<Point2D>& centers)
+{
+    const int n = centers.size();
+    geo.valid = false;
+    if (n == 0 || n != geo.n) return;
+
+    // 三个核矩阵 (第 j 段为源段，沿其长度积分)
+    Eigen::MatrixXd L(n, n), P2(n, n), Q2(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = i; j < n; ++j) {
+            double d = std::abs(centers[i].x - centers[j].x);
+            double dy = centers[i].y - centers[j].y;
+            LineAntiderivative hi = lineAntiderivative(d, dy + geo.h);
+            LineAntiderivative lo = lineAntiderivative(d, dy - geo.h);
+            L(i, j) = L(j, i) = -(hi.lnInt - lo.lnInt);
+            P2(i, j) = P2(j, i) = hi.r2Int - lo.r2Int;
+            Q2(i, j) = Q2(j, i) = hi.r2lnInt - lo.r2lnInt;
+        }
+    }
+
+    Eigen::PartialPivLU<Eigen::MatrixXd> lu(L);
+    Eigen::VectorXd u0 = lu.solve(Eigen::VectorXd::Ones(n));
+    if (!u0.allFinite()) return;
+
+    Eigen::VectorXd pu = P2 * u0;
+    Eigen::VectorXd qu = Q2 * u0;
+    Eigen::VectorXd lpu = lu.solve(pu);
+    Eigen::VectorXd lqu = lu.solve(qu);
+
+    geo.s0 = u0.sum();
+    geo.p2 = u0.dot(pu);
+    geo.q2 = u0.dot(qu);
+    geo.a11 = pu.dot(lpu);
+    geo.a12 = pu.dot(lqu);
+    geo.a22 = qu.dot(lqu);
+    geo.valid = std::isfinite(geo.s0) && std::isfinite(geo.p2) && std::isfinite(geo.q2)
+                && std::isfinite(geo.a11) && std::isfinite(geo.a12) && std::isfinite(geo.a22);
+}
@@ -0,0 +1,140 @@
+/*
+ * 文件名: bemasymptotes.h
+ * 文件作用: 边界元井底压力的早期/晚期渐近解头文件
+ * 功能描述:
+ * 1. 早期 (z 很大，裂缝线性流): K0(γr) 在远小于段长与缝间距的距离内衰减，
+ *    各段只与自身作用，G ≈ g_self·I，pw = g_self / (z·N·M12·2LfD)，g_self 为自感应项的解析积分。
+ *    误差界: 同缝相邻段尾部 2K0(ah)/a、相邻裂缝 2π e^{-a·Δ}/(a(1-e^{-a·Δ}))、复合区反射项三部分
+ *    与 |g_self| 之比 (a = Re γ，Δ 为缝间距)。
+ * 2. 晚期 (z 很小，拟径向流/边界控制流): γ·Dmax ≪ 1 时 K0(γr) + Ac·I0(γr) 按小参数展开为
+ *    κ - ln r + (γ²/4)(κ2·r² - r²·ln r)，κ = -ln(γ/2) - γE + Ac，κ2 = κ + 1。
+ *    常数项为秩一矩阵，由 Sherman-Morrison 公式化为只依赖几何的 u0 = L⁻¹1 (L_ij = -∫ln r)，
+ *    二阶项 δ = (γ²/4)(κ2·P2 - Q2) 按摄动展开到二阶:
+ *        σ = 1ᵀG⁻¹1 ≈ s0/t - u0ᵀδu0/t² + [(δu0)ᵀL⁻¹(δu0) - β(u0ᵀδu0)²/t]/t²，t = 1 + β·s0，β = 2h·κ，
+ *    几何标量 s0 = Σu0、p2 = u0ᵀP2u0、q2 = u0ᵀQ2u0 及 a11、a12、a22 (P2u0、Q2u0 关于 L⁻¹ 的二次型)
+ *    每种几何只计算一次，每个 z 的计算量为 O(1)，复合区与外边界的影响完全包含在系数 Ac 中。
+ *    误差估计: 摄动级数下一项 (|c2|²/|c1|) 与级数截断项 (γ·Dmax)²/16·|c1| 之和相对 σ (各项取绝对值之和，避免抵消造成低估)。
+ *    这是下一项的估计而非严格上界，调用方缺省不使用晚期分支 (asymptoticLate)，需用校验模式确认后再开启。
+ * 3. 误差界 (晚期为误差估计) 小于容差时返回渐近解，否则返回 None，由调用方完成完整的边界元求解。
+ * 4. 实数 (Stehfest) 与复数 (Talbot / de Hoog) Laplace 变量共用模板实现。
+ * 5. 几何分两级: 早期判据与晚期区间判据 |γ|·Dmax < 0.5 只需段长、缝间距、Dmax 等 O(n) 标量；
+ *    晚期所需的稠密 n×n 核矩阵与 LU 分解只在晚期判据成立时由调用方按需提供 (H 矩阵模式下不提供)。
+ */
+
+#ifndef BEMASYMPTOTES_H
+#define BEMASYMPTOTES_H
+
+#include <QVector>
+#include <cmath>
+#include <complex>
+
+#include "specialfunctions.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+struct Point2D;
+
+// 渐近解所需的几何标量 (只依赖裂缝段布置)
+struct BemAsymptoteGeometry
+{
+    bool valid = false;    // 晚期标量 (s0 ~ a22) 已计算且有限
+    int n = 0;             // 总段数
+    int nf = 0;            // 裂缝条数
+    double h = 0.0;        // 半段长
+    double spacingD = 0.0; // 缝间距
+    double dMax = 0.0;     // 任意两点间的最大距离
+    double s0 = 0.0;       // Σ u0，u0 = L⁻¹1
+    double p2 = 0.0;       // u0ᵀ P2 u0，P2_ij = ∫ r²
+    double q2 = 0.0;       // u0ᵀ Q2 u0，Q2_ij = ∫ r² ln r
+    double a11 = 0.0;      // (P2u0)ᵀ L⁻¹ (P2u0)
+    double a12 = 0.0;      // (P2u0)ᵀ L⁻¹ (Q2u0)
+    double a22 = 0.0;      // (Q2u0)ᵀ L⁻¹ (Q2u0)
+};
+
+class BemAsymptotes
+{
+public:
+    enum Regime { None = 0, Early, Late };
+
+    // 由裂缝段中心计算区间判据用的标量 (段数、半段长、缝间距、Dmax)，O(n)
+    static void computeBounds(BemAsymptoteGeometry& geo, const QVector<Point2D>& centers,
+                              int nf, double segLen, double spacingD);
+    // 在 computeBounds 的基础上计算晚期标量 (三个 n×n 核矩阵 + 对数核矩阵一次稠密分解)；矩阵奇异时 valid 为 false
+    static void computeLateGeometry(BemAsymptoteGeometry& geo, const QVector<Point2D>& centers);
+
+    /**
+     * @brief 判断渐近区间并求井底压力项 pw
+     * @param z Laplace 变量
+     * @param gamma 内区 γ = sqrt(z·fs1)
+     * @param acPrefactor, argRm 复合区反射项系数 (Ac = acPrefactor·e^{-argRm}) 与 γ·rmD
+     * @param scale M12·2LfD (影响系数的归一化因子)
+     * @param geo computeBounds 给出的区间判据标量
+     * @param lateGeometry 晚期判据成立时才调用，返回带晚期标量的几何 (nullptr 表示不使用晚期渐近解)
+     * @param tol 相对误差界容差
+     * @param pw 返回渐近解 (仅在返回值不为 None 时有效)
+     */
+    template <typename T, typename LateGeometry>
+    static Regime evaluate(const T& z, const T& gamma, const T& acPrefactor, const T& argRm, double scale,
+                           const BemAsymptoteGeometry& geo, LateGeometry&& lateGeometry, double tol, T& pw)
+    {
+        if (geo.n <= 0) return None;
+        const double a = std::real(gamma);
+        if (!(a > 0.0)) return None;
+
+        // --- 早期: 段间作用可忽略 ---
+        if (a * geo.h > 5.0) {
+            T gSelf = SpecialFunctions::integralK0Line(gamma, -geo.h, geo.h);
+            double bound = 2.0 * SpecialFunctions::besselK0(a * geo.h) / a;
+            if (geo.nf > 1) {
+                double q = std::exp(-a * geo.spacingD);
+                bound += 2.0 * M_PI * q / (a * (1.0 - q));
+            }
+            double acExponent = a * geo.dMax - std::real(argRm);
+            if (acExponent > -700.0) bound += geo.n * 2.0 * geo.h * std::abs(acPrefactor) * std::exp(acExponent);
+            if (bound < tol * std::abs(gSelf)) {
+                pw = gSelf / (z * (double)geo.n * scale);
+                return Early;
+            }
+            return None;
+        }
+
+        // --- 晚期: 小参数展开 + 秩一 Sherman-Morrison + 二阶摄动 ---
+        const double gd = std::abs(gamma) * geo.dMax;
+        if (gd < 0.5) {
+            const BemAsymptoteGeometry* late = lateGeometry();
+            if (!late || !late->valid) return None;
+            const BemAsymptoteGeometry& lg = *late;
+            const double eulerGamma = 0.57721566490153286061;
+            T Ac = (std::real(argRm) < 700.0) ? acPrefactor * std::exp(-argRm) : T(0.0);
+            T kappa = -std::log(gamma * 0.5) - eulerGamma + Ac;
+            T kappa2 = kappa + 1.0;
+            T t = 1.0 + 2.0 * lg.h * kappa * lg.s0;
+            if (!(std::abs(t) > 1e-12)) return None;
+
+            T beta = 2.0 * lg.h * kappa;
+            T sigma0 = lg.s0 / t;
+            T g2 = gamma * gamma * 0.25;
+            T c1 = g2 * (kappa2 * lg.p2 - lg.q2) / (t * t);
+            T c2 = g2 * g2 * (kappa2 * kappa2 * lg.a11 - 2.0 * kappa2 * lg.a12 + lg.a22) / (t * t)
+                   - beta * c1 * c1 * t;
+
+            // 各项幅值取绝对值之和
+            const double tAbs = std::abs(t), kAbs = std::abs(kappa2), gAbs = std::abs(g2);
+            double c1Mag = gAbs * (kAbs * std::abs(lg.p2) + std::abs(lg.q2)) / (tAbs * tAbs);
+            double c2Mag = gAbs * gAbs * (kAbs * kAbs * std::abs(lg.a11) + 2.0 * kAbs * std::abs(lg.a12)
+                                          + std::abs(lg.a22)) / (tAbs * tAbs)
+                           + std::abs(beta) * c1Mag * c1Mag * tAbs;
+            double bound = (c1Mag > 0.0 ? c2Mag * c2Mag / c1Mag : 0.0) + c1Mag * gd * gd / 16.0;
+            bound /= std::abs(sigma0);
+            if (std::isfinite(bound) && bound < tol) {
+                pw = 1.0 / (z * scale * (sigma0 - c1 + c2));
+                return Late;
+            }
+        }
+        return None;
+    }
+};
+
+#endif // BEMASYMPTOTES_H
@@ -0,0 +1,145 @@
+/*
+ * 文件名: bemworkspace.cpp
+ * 文件作用: 边界元求解工作区实现
+ * 功能描述:
+ * 1. 几何键比较与裂缝段中心重建。
+ * 2. 系数矩阵、右端项、解向量、LU 分解及偏移量表按尺寸惰性分配，每次真实分配计数一次。
+ * 3. 工作区池: 互斥锁保护空闲列表，借出/归还只是指针移动；分配计数器随借出设置、随归还清除。
+ * 4. 渐近解几何标量在几何变化后首次使用时计算，晚期标量 (稠密分解) 推迟到首次进入晚期区间时。
+ * 5. 灵敏度积分表 (5 张偏移量表连续存放) 按尺寸惰性分配。
+ */
+
+#include "bemworkspace.h"
+
+#include <QMutexLocker>
+
+void BemWorkspace::countAllocation(int n)
+{
+    if (allocationCounter) *allocationCounter += n;
+}
+
+void BemWorkspace::prepareGeometry(const ModelSolverParams& p)
+{
+    if (nf == p.nf && nSeg == p.nSeg && LfD == p.LfD && spacingD == p.spacingD) return;
+
+    nf = p.nf;
+    nSeg = p.nSeg;
+    LfD = p.LfD;
+    spacingD = p.spacingD;
+    segLen = 2.0 * LfD / nSeg;
+    asymptotesReady = false;
+    lateAsymptotesReady = false;
+
+    // 裂缝沿 x 方向等间距居中排列，每条裂缝沿 y 方向均分为 n_seg 段
+    int total = nf * nSeg;
+    if (segmentCenters.capacity() < total) countAllocation();
+    segmentCenters.clear();
+    segmentCenters.reserve(total);
+    double startX = -(nf - 1) * spacingD / 2.0;
+    for (int k = 0; k < nf; ++k) {
+        double currentX = startX + k * spacingD;
+        for (int i = 0; i < nSeg; ++i) {
+            double currentY = -LfD + (i + 0.5) * segLen;
+            segmentCenters.append({currentX, currentY});
+        }
+    }
+}
+
+void BemWorkspace::prepareReal()
+{
+    int total = nf * nSeg;
+    if (A.rows() != total) {
+        // 矩阵、三个工作向量及 LU 分解 (LU 矩阵、置换、行交换) 共 7 块存储
+        A.resize(total, total);
+        x.resize(total);
+        d.resize(total);
+        w.resize(total);
+        lu = Eigen::PartialPivLU<Eigen::MatrixXd>(total);
+        countAllocation(7);
+    }
+    if (offsetTable.size() != total) {
+        offsetTable.resize(total);
+        countAllocation();
+    }
+}
+
+void BemWorkspace::prepareComplex()
+{
+    int total = nf * nSeg;
+    if (Ac.rows() != total) {
+        Ac.resize(total, total);
+        xc.resize(total);
+        dc.resize(total);
+        wc.resize(total);
+        luc = Eigen::PartialPivLU<Eigen::MatrixXcd>(total);
+        countAllocation(7);
+    }
+    if (offsetTableC.size() != total) {
+        offsetTableC.resize(total);
+        countAllocation();
+    }
+}
+
+void BemWorkspace::prepareSensitivity()
+{
+    int total = nf * nSeg;
+    if (sensitivityTables.size() != 5 * total) {
+        sensitivityTables.resize(5 * total);
+        countAllocation();
+    }
+}
+
+const BemAsymptoteGeometry& BemWorkspace::prepareAsymptotes()
+{
+    if (!asymptotesReady) {
+        BemAsymptotes::computeBounds(asymptotes, segmentCenters, nf, segLen, spacingD);
+        asymptotesReady = true;
+    }
+    return asymptotes;
+}
+
+const BemAsymptoteGeometry* BemWorkspace::prepareLateAsymptotes()
+{
+    prepareAsymptotes();
+    if (!lateAsymptotesReady) {
+        BemAsymptotes::computeLateGeometry(asymptotes, segmentCenters);
+        lateAsymptotesReady = true;
+    }
+    return &asymptotes;
+}
+
+BemWorkspacePool::BemWorkspacePool() {}
+
+BemWorkspacePool::~BemWorkspacePool()
+{
+    qDeleteAll(m_all);
+}
+
+BemWorkspacePool::Lease BemWorkspacePool::acquire(std::atomic<long long>* allocationCounter)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_free.isEmpty()) {
+        BemWorkspace* ws = m_free.last();
+        m_free.removeLast();
+        ws->allocationCounter = allocationCounter;
+        return Lease(this, ws);
+    }
+    BemWorkspace* ws = new BemWorkspace;
+    ws->allocationCounter = allocationCounter;
+    m_all.append(ws);
+    if (allocationCounter) *allocationCounter += 1;
+    return Lease(this, ws);
+}
+
+void BemWorkspacePool::release(BemWorkspace* ws)
+{
+    QMutexLocker locker(&m_mutex);
+    ws->allocationCounter = nullptr;
+    m_free.append(ws);
+}
+
+int BemWorkspacePool::workspaceCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_all.size();
+}
@@ -0,0 +1,121 @@
+/*
+ * 文件名: bemworkspace.h
+ * 文件作用: 边界元求解工作区 (可复用缓冲区) 头文件
+ * 功能描述:
+ * 1. BemWorkspace 保存一次 PWD_composite 计算需要的全部存储:
+ *    裂缝段中心几何、Toeplitz 偏移量表、对称系数矩阵、LDLᵀ 工作向量、退回用 LU 缓冲区 (实数与复数各一套)。
+ * 2. 几何只依赖 (nf, n_seg, LfD, spacingD)，参数不变时直接复用，不再随每个 Laplace 变量 z 重建；
+ *    矩阵与分解缓冲区在尺寸不变时原地覆盖，求解阶段不再申请堆内存。
+ * 3. BemWorkspacePool 由求解器持有: 每个并行任务借出一个工作区，用完归还，
+ *    同一时刻的工作区数量不超过并行线程数，工作区随求解器一同释放。
+ * 4. 统计缓冲区分配次数，用于对比每条曲线的堆分配次数。
+ * 5. 缓存早期/晚期渐近解所需的几何标量 (仅在启用渐近捷径时按需计算；晚期的稠密矩阵分解只在进入晚期区间时计算)。
+ * 6. 形状参数灵敏度使用的偏移量积分表与 yᵀ(·)y 权重表 (仅在计算灵敏度时分配)。
+ * 7. 分配次数记入借出时给出的计数器 (发起曲线计算一方的统计)，池本身不再持有计数，并发的曲线互不清零。
+ */
+
+#ifndef BEMWORKSPACE_H
+#define BEMWORKSPACE_H
+
+#include <QVector>
+#include <QMutex>
+#include <Eigen/Dense>
+#include <complex>
+#include <atomic>
+
+#include "modelsolverparams.h"
+#include "hmatrixbem.h"
+#include "bemasymptotes.h"
+
+// 裂缝段中心坐标 (无因次)
+struct Point2D { double x; double y; };
+
+struct BemWorkspace
+{
+    // --- 几何 (键: nf, n_seg, LfD, spacingD) ---
+    int nf = -1;
+    int nSeg = -1;
+    double LfD = 0.0;
+    double spacingD = 0.0;
+    double segLen = 0.0;
+    QVector<Point2D> segmentCenters;
+    BemAsymptoteGeometry asymptotes;  // 渐近解几何标量 (随几何重建失效)
+    bool asymptotesReady = false;     // 区间判据标量已计算
+    bool lateAsymptotesReady = false; // 晚期标量 (稠密矩阵分解) 已计算
+
+    // --- 实数求解缓冲区 ---
+    Eigen::MatrixXd A;        // 对称影响系数矩阵 (不含加边行列)
+    Eigen::VectorXd x;        // y = A⁻¹1
+    Eigen::VectorXd d;        // LDLᵀ 对角元
+    Eigen::VectorXd w;        // LDLᵀ 列更新临时向量
+    Eigen::PartialPivLU<Eigen::MatrixXd> lu;
+    QVector<double> offsetTable;
+    HMatrixBem<double> hmat;  // H 矩阵模式的分块结构与压缩数据
+    QVector<double> sensitivityTables; // 灵敏度积分表 E、Ĩ、Γ、D 与权重 W (各 nf*n_seg 项)
+
+    // --- 复数求解缓冲区 (Talbot / de Hoog) ---
+    Eigen::MatrixXcd Ac;
+    Eigen::VectorXcd xc;
+    Eigen::VectorXcd dc;
+    Eigen::VectorXcd wc;
+    Eigen::PartialPivLU<Eigen::MatrixXcd> luc;
+    QVector<std::complex<double>> offsetTableC;
+    HMatrixBem<std::complex<double>> hmatC;
+
+    std::atomic<long long>* allocationCounter = nullptr;   // 借出期间的分配计数器 (可为空)
+
+    // 几何参数变化时重建裂缝段中心
+    void prepareGeometry(const ModelSolverParams& p);
+    // 按当前几何准备实数/复数缓冲区 (尺寸不变时不重新分配)
+    void prepareReal();
+    void prepareComplex();
+    // 按当前几何准备灵敏度积分表 (在 prepareReal 之后调用)
+    void prepareSensitivity();
+    // 按当前几何准备渐近区间判据标量 (O(n)，每种几何只计算一次)
+    const BemAsymptoteGeometry& prepareAsymptotes();
+    // 按当前几何准备晚期渐近解标量 (稠密 n×n 分解，只在首次进入晚期区间时计算)
+    const BemAsymptoteGeometry* prepareLateAsymptotes();
+
+private:
+    void countAllocation(int n = 1);
+};
+
+class BemWorkspacePool
+{
+public:
+    // 借出的工作区，析构时自动归还
+    class Lease
+    {
+    public:
+        Lease(BemWorkspacePool* pool, BemWorkspace* ws) : m_pool(pool), m_ws(ws) {}
+        ~Lease() { m_pool->release(m_ws); }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        BemWorkspace* operator->() const { return m_ws; }
+        BemWorkspace& operator*() const { return *m_ws; }
+
+    private:
+        BemWorkspacePool* m_pool;
+        BemWorkspace* m_ws;
+    };
+
+    BemWorkspacePool();
+    ~BemWorkspacePool();
+
+    // 借出一个空闲工作区 (没有空闲时新建)，随返回的 Lease 析构归还；
+    // 借出期间的缓冲区分配次数 (含新建工作区) 累加到 allocationCounter (为空时不计数)
+    Lease acquire(std::atomic<long long>* allocationCounter = nullptr);
+
+    // 已创建的工作区数量 (约等于参与计算的线程数)
+    int workspaceCount() const;
+
+private:
+    void release(BemWorkspace* ws);
+
+    QVector<BemWorkspace*> m_all;
+    QVector<BemWorkspace*> m_free;
+    mutable QMutex m_mutex;
+};
+
+#endif // BEMWORKSPACE_H
@@ -0,0 +1,112 @@
+/*
+ * 文件名: borderedsolver.h
+ * 文件作用: 裂缝流量方程的对称加边线性系统求解器 (仅头文件)
+ * 功能描述:
+ * 1. 边界元方程组为对称影响系数矩阵 G 加一行 z、一列 -1 的加边系统:
+ *        [ G   -1 ] [q ]   [0]
+ *        [ z1ᵀ  0 ] [pw] = [1]
+ *    由 q = pw·G⁻¹1 与 z·Σq = 1 得 pw = 1 / (z·Σy)，y = G⁻¹1 (Schur 补只是一个标量)。
+ * 2. 只对对称块 G 做 LDLᵀ 分解 (约 n³/3 次乘法，为全矩阵 LU 的一半)，再做一次前代、一次回代。
+ * 3. 分解只写 G 的严格下三角，上三角与对角线保持原值；主元过小或结果非有限时，
+ *    由上三角恢复完整 G 并退回部分主元 LU，保证与原算法同样稳健。
+ * 4. pw = 1/(z·Σy) 的计算单独提供，供 H 矩阵迭代求解 (HMatrixBem) 复用。
+ * 5. 以模板实现，实数 (Stehfest) 与复对称 (Talbot / de Hoog，转置而非共轭转置) 共用。
+ */
+
+#ifndef BORDEREDSOLVER_H
+#define BORDEREDSOLVER_H
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <complex>
+#include <algorithm>
+
+class BorderedSolver
+{
+public:
+    /**
+     * @brief 求解加边系统，返回井底压力项 pw
+     * @param G 对称影响系数矩阵 (n×n，需完整填写)；返回时严格下三角被 L 覆盖 (退回 LU 时恢复原值)
+     * @param z Laplace 变量
+     * @param d, w, y 长度 n 的工作向量 (不重新分配)
+     * @param lu 退回路径使用的 LU 分解缓冲区
+     * @param usedFallback 可选，返回是否退回了 LU
+     */
+    template <typename Scalar>
+    static Scalar solve(Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& G, const Scalar& z,
+                        Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& d,
+                        Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& w,
+                        Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& y,
+                        Eigen::PartialPivLU<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>& lu,
+                        bool* usedFallback = nullptr)
+    {
+        const int n = (int)G.rows();
+        bool ok = factorLDLT(G, d, w);
+        if (ok) {
+            // y = G⁻¹1: L u = 1，v = D⁻¹u，Lᵀ y = v
+            y.setOnes();
+            G.template triangularView<Eigen::UnitLower>().solveInPlace(y);
+            y.array() /= d.array();
+            G.template triangularView<Eigen::UnitLower>().transpose().solveInPlace(y);
+            ok = std::isfinite(std::abs(y.sum()));
+        }
+        if (!ok) {
+            // 由上三角恢复下三角后做部分主元 LU
+            for (int j = 0; j < n; ++j) {
+                for (int i = j + 1; i < n; ++i) G(i, j) = G(j, i);
+            }
+            lu.compute(G);
+            y = lu.solve(Eigen::Matrix<Scalar, Eigen::Dynamic, 1>::Ones(n));
+        }
+        if (usedFallback) *usedFallback = !ok;
+        return wellborePressure(z, y);
+    }
+
+    // 由 y = G⁻¹1 得井底压力项 pw = 1 / (z·Σy) (直接法与迭代法共用)
+    template <typename Scalar>
+    static Scalar wellborePressure(const Scalar& z, const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& y)
+    {
+        Scalar denom = z * y.sum();
+        if (std::abs(denom) < 1e-300) return Scalar(0.0);
+        return Scalar(1.0) / denom;
+    }
+
+private:
+    /**
+     * @brief 无主元 LDLᵀ 分解 (对称，非共轭)
+     * 第 j 列: d_j = G_jj - Σ_k L_jk² d_k，L(j+1:n, j) = (G(j, j+1:n)ᵀ - L(j+1:n, 0:j)·w) / d_j，w_k = L_jk d_k。
+     * 读取上三角与对角线的原值，只写严格下三角；列更新为矩阵-向量乘积，按列存储连续访问。
+     * @return 主元相对对角线最大值过小 (近奇异或需要主元交换) 时返回 false
+     */
+    template <typename Scalar>
+    static bool factorLDLT(Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& G,
+                           Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& d,
+                           Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& w)
+    {
+        const int n = (int)G.rows();
+        double maxDiag = 0.0;
+        for (int j = 0; j < n; ++j) maxDiag = std::max(maxDiag, (double)std::abs(G(j, j)));
+        if (!(maxDiag > 0.0) || !std::isfinite(maxDiag)) return false;
+        const double pivotTol = 1e-12 * maxDiag;
+
+        for (int j = 0; j < n; ++j) {
+            const int m = n - j - 1;
+            Scalar dj = G(j, j);
+            if (j > 0) {
+                w.head(j) = G.row(j).head(j).transpose().cwiseProduct(d.head(j));
+                dj -= G.row(j).head(j).transpose().cwiseProduct(w.head(j)).sum();  // 非共轭内积
+            }
+            if (!(std::abs(dj) > pivotTol)) return false;
+            d(j) = dj;
+
+            if (m > 0) {
+                G.col(j).tail(m) = G.row(j).tail(m).transpose();
+                if (j > 0) G.col(j).tail(m).noalias() -= G.block(j + 1, 0, m, j) * w.head(j);
+                G.col(j).tail(m) /= dj;
+            }
+        }
+        return true;
+    }
+};
+
+#endif // BORDEREDSOLVER_H
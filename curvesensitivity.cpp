@@ -0,0 +1,199 @@
+/*
+ * 文件名: curvesensitivity.cpp
+ * 文件作用: 理论曲线参数灵敏度实现
+ * 功能描述:
+ * 1. (时间点 × Stehfest 项) 的内核灵敏度求值以任务形式提交到全局工作窃取调度器，与曲线计算相同。
+ * 2. Stehfest 求和: PD = (ln2/t)ΣV_m F_m，t·dPD/dt = (ln2)²/t·Σm·V_m F_m，参数导数把 F_m 换成 ∂F_m/∂θ，
+ *    均以 long double 累加。
+ * 3. 时间系数方向: 对反演所得曲线本身沿 ln t 求导 (Stehfest 求值点 z_m = m·ln2/t 随 t 移动)，
+ *    d PD/d ln t = -PD - (ln2)²/t²·Σm·V_m F'_m，d(t·dPD/dt)/d ln t = -t·dPD/dt - (ln2)³/t²·Σm²·V_m F'_m，
+ *    F' 由内核在同一次边界元求解中给出，不另外求解曲线，与残差曲线一致；
+ *    不用 Σm²·V_m F_m 直接求二阶项 (t²·d²PD/dt² 的反演)，那样会把 Stehfest 的抵消误差放大 m² 倍且与反演曲线的导数不一致。
+ * 4. 链式系数的差分步长为参数值的 1e-6 (零值参数取绝对步长 1e-12)，换算中不含任何曲线计算。
+ * 5. H 矩阵模式下返回 false (稠密组装既与残差的离散方式不同，也失去 H 矩阵在大规模离散下的意义)，由调用方退回差分。
+ */
+
+#include "curvesensitivity.h"
+#include "laplaceinversion.h"
+#include "stehfesttable.h"
+#include "taskscheduler.h"
+
+#include <cmath>
+#include <algorithm>
+
+CurveSensitivity::Mapping CurveSensitivity::mapping(const QMap<QString, double>& params, int maxN)
+{
+    Mapping m;
+
+    // 1. 与求解器 calculateTheoreticalCurve 相同的缺省值与合法性判断
+    double phi = params.value("phi", 0.05);
+    double mu = params.value("mu", 0.5);
+    double B = params.value("B", 1.05);
+    double Ct = params.value("Ct", 5e-4);
+    double q = params.value("q", 5.0);
+    double h = params.value("h", 20.0);
+    double kf = params.value("kf", 1e-3);
+    double L = params.value("L", 1000.0);
+    if (L < 1e-9) L = 1000.0;
+    m.timeCoeff = 14.4 * kf / (phi * mu * Ct * L * L);
+    m.pressureCoeff = 1.842e-3 * q * mu * B / (kf * h);
+    m.valid = !(phi < 1e-12 || mu < 1e-12 || Ct < 1e-12 || kf < 1e-12)
+              && m.timeCoeff > 0.0 && m.pressureCoeff > 0.0 && std::isfinite(m.pressureCoeff);
+
+    // 2. 内核参数块 (Stehfest 阶数按求解器规则校验)
+    m.solver = ModelSolverParams::fromMap(params);
+    int N = m.solver.N;
+    if (N < 4 || N > maxN || N % 2 != 0) N = 10;
+    m.solver.N = N;
+
+    for (int k = 0; k < ModelSolverParams::SensitivityCount; ++k) {
+        m.value[k] = m.solver.*ModelSolverParams::sensitivityMember(k);
+    }
+    m.value[GamaDIndex] = m.solver.gamaD;
+    m.value[LogTimeIndex] = m.valid ? std::log(m.timeCoeff) : 0.0;
+    m.value[LogPressureIndex] = m.valid ? std::log(m.pressureCoeff) : 0.0;
+    return m;
+}
+
+bool CurveSensitivity::sameDiscrete(const Mapping& a, const Mapping& b)
+{
+    return a.solver.nf == b.solver.nf && a.solver.nSeg == b.solver.nSeg && a.solver.spacingD == b.solver.spacingD
+           && a.solver.N == b.solver.N && a.solver.inversion == b.solver.inversion
+           && a.solver.analyticDeriv == b.solver.analyticDeriv;
+}
+
+bool CurveSensitivity::compute(const ModelKernel* kernel, BemKernelContext& ctx, BemKernelStats& stats,
+                               const QMap<QString, double>& params, const QVector<double>& time, const QStringList& names, int maxN, Result& out)
+{
+    out = Result();
+    if (!kernel || !kernel->sensitivity || time.isEmpty()) return false;
+    const Mapping base = mapping(params, maxN);
+    if (!base.valid || base.solver.inversion != LaplaceInversion::Stehfest || !base.solver.analyticDeriv) return false;
+    if (base.solver.bemHMatrix) return false;
+    const ModelSolverParams& sp = base.solver;
+
+    // 1. 各参数名的链式系数: ∂(无因次量)/∂参数
+    QStringList used;
+    QVector<QVector<double>> chain;
+    unsigned mask = 0;
+    for (const QString& name : names) {
+        if (!params.contains(name) || used.contains(name)) continue;
+        double value = params.value(name);
+        double step = std::max(1e-6 * std::abs(value), 1e-12);
+        QMap<QString, double> plus = params;
+        QMap<QString, double> minus = params;
+        plus[name] = value + step;
+        minus[name] = value - step;
+        Mapping mp = mapping(plus, maxN);
+        Mapping mm = mapping(minus, maxN);
+        if (!mp.valid || !mm.valid || !sameDiscrete(mp, base) || !sameDiscrete(mm, base)) continue;
+
+        QVector<double> c(ValueCount);
+        for (int k = 0; k < ValueCount; ++k) c[k] = (mp.value[k] - mm.value[k]) / (2.0 * step);
+        for (int k = 0; k < ModelSolverParams::SensitivityCount; ++k) {
+            if (c[k] != 0.0) mask |= 1u << k;
+        }
+        used.append(name);
+        chain.append(c);
+    }
+
+    // 2. (时间点 × Stehfest 项) 的 Laplace 解、形状参数导数与 (需要时) 对 z 的导数，每项一次边界元求解
+    bool needTime = false;
+    for (const QVector<double>& c : chain) needTime = needTime || c[LogTimeIndex] != 0.0;
+    const int n = time.size();
+    const int N = sp.N;
+    const int F = ModelSolverParams::SensitivityCount;
+    const int Z = F + 1;          // 对 z 的导数所在分量
+    const int stride = F + 2;
+    const double ln2 = 0.6931471805599453;
+    const long double* stehfest = StehfestTable::rowLong(N);
+    QVector<double> tD(n);
+    for (int i = 0; i < n; ++i) tD[i] = base.timeCoeff * time[i];
+
+    QVector<double> values(n * N * stride, 0.0);
+    TaskScheduler::instance().parallelFor(n * N, [&](int task) {
+        double t = tD[task / N];
+        if (t <= 1e-10) return;
+        double z = (task % N + 1) * ln2 / t;
+        double* v = values.data() + task * stride;
+        // 只有压力尺度参数与 γD 时不需要任何导数，直接使用普通 Laplace 解 (可走渐近捷径)
+        v[0] = (mask || needTime) ? kernel->sensitivity(z, sp, ctx, stats, mask, v + 1, needTime ? v + Z : nullptr)
+                                  : kernel->laplace(z, sp, ctx, stats);
+        bool finite = true;
+        for (int c = 0; c < stride; ++c) finite = finite && std::isfinite(v[c]);
+        if (!finite) std::fill(v, v + stride, 0.0);
+    });
+
+    // 3. Stehfest 求和、压敏链式法则与尺度系数
+    out.pressure = QVector<double>(n, 0.0);
+    out.derivative = QVector<double>(n, 0.0);
+    for (const QString& name : used) {
+        out.dPressure[name] = QVector<double>(n, 0.0);
+        out.dDerivative[name] = QVector<double>(n, 0.0);
+    }
+    const double gamaD = sp.gamaD;
+    const double cp = base.pressureCoeff;
+    QVector<long double> s0(stride), s1(stride);
+    QVector<double> pdField(F), dpdField(F);
+    for (int i = 0; i < n; ++i) {
+        const double t = tD[i];
+        if (t <= 1e-10) continue;
+        std::fill(s0.begin(), s0.end(), 0.0L);
+        std::fill(s1.begin(), s1.end(), 0.0L);
+        long double s2Z = 0.0L;
+        for (int m = 1; m <= N; ++m) {
+            const double* v = values.constData() + (i * N + m - 1) * stride;
+            for (int c = 0; c < stride; ++c) {
+                long double term = stehfest[m] * v[c];
+                s0[c] += term;
+                s1[c] += m * term;
+            }
+            s2Z += (long double)m * m * stehfest[m] * v[Z];
+        }
+        const double pd0 = (double)s0[0] * ln2 / t;
+        const double dpd0 = (double)s1[0] * ln2 * ln2 / t;
+        for (int f = 0; f < F; ++f) {
+            pdField[f] = (double)s0[f + 1] * ln2 / t;
+            dpdField[f] = (double)s1[f + 1] * ln2 * ln2 / t;
+        }
+
+        // 压敏: PD = -ln(1-γ·PD0)/γ，∂PD/∂PD0 = a = 1/(1-γ·PD0)，γ→0 时取极限
+        double a = 1.0, curvature = 0.0;
+        double pd = pd0, dpd = dpd0;
+        double pdGama = 0.5 * pd0 * pd0, dpdGama = dpd0 * pd0;
+        if (std::abs(gamaD) > 1e-9) {
+            double arg = 1.0 - gamaD * pd0;
+            if (arg > 1e-12) {
+                a = 1.0 / arg;
+                curvature = gamaD * a * a;
+                pd = -std::log(arg) / gamaD;
+                dpd = a * dpd0;
+                pdGama = pd0 * a / gamaD + std::log(arg) / (gamaD * gamaD);
+                dpdGama = dpd0 * pd0 * a * a;
+            } else {
+                pdGama = dpdGama = 0.0;
+            }
+        }
+        out.pressure[i] = cp * pd;
+        out.derivative[i] = cp * dpd;
+        // 时间系数方向 (压敏变换前): 求值点 z_m = m·ln2/t 随 t 移动，由 F'(z_m) 得反演曲线沿 ln t 的导数
+        const double pdTime0 = -pd0 - (double)s1[Z] * ln2 * ln2 / (t * t);
+        const double dpdTime0 = -dpd0 - (double)s2Z * ln2 * ln2 * ln2 / (t * t);
+        const double pdTime = a * pdTime0;
+        const double dpdTime = a * dpdTime0 + curvature * dpd0 * pdTime0;
+
+        for (int j = 0; j < used.size(); ++j) {
+            const QVector<double>& c = chain[j];
+            double sumP = c[GamaDIndex] * pdGama + c[LogTimeIndex] * pdTime;
+            double sumD = c[GamaDIndex] * dpdGama + c[LogTimeIndex] * dpdTime;
+            for (int f = 0; f < F; ++f) {
+                if (c[f] == 0.0) continue;
+                sumP += c[f] * a * pdField[f];
+                sumD += c[f] * (a * dpdField[f] + curvature * dpd0 * pdField[f]);
+            }
+            out.dPressure[used[j]][i] = cp * sumP + c[LogPressureIndex] * out.pressure[i];
+            out.dDerivative[used[j]][i] = cp * sumD + c[LogPressureIndex] * out.derivative[i];
+        }
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+/*
+ * 文件名: curvesensitivity.h
+ * 文件作用: 理论曲线参数灵敏度 (解析雅可比矩阵) 头文件
+ * 功能描述:
+ * 1. 内核 (ModelKernel::sensitivity) 在每个 Stehfest 求值点上一次给出 Laplace 解及其对全部形状参数的导数，
+ *    在同一组求值点上求和得到 ∂PD/∂θ 与 ∂(t·dPD/dt)/∂θ，不再为每个参数重算整条曲线。
+ * 2. 尺度参数只进入压力系数与时间系数: ∂p/∂ln(压力系数) = p，∂p/∂ln(时间系数) = t·dp/dt，
+ *    后者由同一组求值点上的 ∂F/∂z 解析求得 (对反演所得曲线本身求导)，不再另外求解曲线，全部时间尺度参数共用。
+ * 3. 压敏系数 γD 在时间域按 PD = -ln(1-γD·PD0)/γD 的链式法则处理。
+ * 4. 参数字典的键到上述无因次量的换算为闭式表达式，按中心差分得到链式系数；
+ *    会改变裂缝条数、离散段数、反演阶数等整数量的键不给出结果，由调用方退回差分。
+ * 5. 复变量反演 (Talbot / de Hoog)、Bourdet 导数与 H 矩阵模式下不适用。
+ *    灵敏度始终按稠密边界元组装、逐段自适应积分，不走渐近捷径、远场分级积分、Laplace 插值与曲线缓存；
+ *    只有在这几项取缺省容差 (1e-10 量级，远小于 Stehfest 反演误差) 时雅可比矩阵与残差曲线的差别才可忽略。
+ *    拟合保真度阶梯的粗、中两级放宽了远场 (1e-8/1e-9) 与渐近 (1e-6/1e-8) 容差，
+ *    这两级由 FittingCore::applyFidelity 关闭解析雅可比，改用中心差分。
+ * 6. 供 ModelSolver01_06 与 ModelSolver19_36 共用。
+ */
+
+#ifndef CURVESENSITIVITY_H
+#define CURVESENSITIVITY_H
+
+#include <QMap>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+
+#include "modelsolverparams.h"
+#include "modelkernelregistry.h"
+
+class CurveSensitivity
+{
+public:
+    struct Result
+    {
+        QVector<double> pressure;                     // 理论压差
+        QVector<double> derivative;                   // 理论压力导数
+        QMap<QString, QVector<double>> dPressure;     // 参数名 -> ∂压差/∂参数
+        QMap<QString, QVector<double>> dDerivative;   // 参数名 -> ∂压力导数/∂参数
+    };
+
+    /**
+     * @brief 计算理论曲线及其对指定参数的灵敏度
+     * @param kernel 模型内核
+     * @param ctx 内核运行环境 (工作区池，与求解器共用)
+     * @param stats 本次计算的统计 (由调用方持有)
+     * @param params 求解器参数字典 (与 calculateTheoreticalCurve 相同)
+     * @param time 时间点
+     * @param names 需要求导的参数名 (不可解析求导的参数不出现在结果中)
+     * @param maxN Stehfest 阶数上限 (超出或非法时取 10，与求解器一致)
+     * @return 是否适用 (复变量反演、Bourdet 导数或基础参数非法时返回 false)
+     */
+    static bool compute(const ModelKernel* kernel, BemKernelContext& ctx, BemKernelStats& stats,
+                        const QMap<QString, double>& params, const QVector<double>& time, const QStringList& names,
+                        int maxN, Result& out);
+
+private:
+    // 无因次量下标: 形状参数之后依次为 γD、ln 时间系数、ln 压力系数
+    enum { GamaDIndex = ModelSolverParams::SensitivityCount, LogTimeIndex, LogPressureIndex, ValueCount };
+
+    // 参数字典换算得到的无因次量与离散量
+    struct Mapping
+    {
+        double value[ValueCount];
+        double timeCoeff;
+        double pressureCoeff;
+        ModelSolverParams solver;
+        bool valid;
+    };
+
+    static Mapping mapping(const QMap<QString, double>& params, int maxN);
+    // 两组换算的离散量 (裂缝条数、离散段数、间距、反演设置) 是否一致
+    static bool sameDiscrete(const Mapping& a, const Mapping& b);
+};
+
+#endif // CURVESENSITIVITY_H
@@ -0,0 +1,236 @@
+/*
+ * 文件名: dimensionlesscurvecache.cpp
+ * 文件作用: 无因次理论曲线缓存实现
+ * 功能描述:
+ * 1. 形状参数按名称排序后以 %.17g 序列化为键，保证同一参数集得到同一键。
+ * 2. 插值采用 Fritsch-Carlson PCHIP (分段三次 Hermite，保单调)，在 ln tD - ln PD 上进行，
+ *    试井曲线在双对数坐标下光滑，插值误差远小于线性插值。
+ * 3. 写入时由调用方在请求范围两端各补两个点 (共外扩 2 倍)，使 phi/Ct/mu/kf 的小幅调整仍可插值；
+ *    请求的正时间点超出缓存曲线范围或缓存曲线含非正值时视为未命中，由调用方重新计算。
+ * 4. 带导数的曲线另对 DPD/PD (即 d ln PD / d ln tD) 建立一组 PCHIP 节点，与 PD 共用插值区间，
+ *    插值结果乘回 PD 得到导数，避免对插值后的 PD 再做数值差分。
+ */
+
+#include "dimensionlesscurvecache.h"
+
+#include <QMutexLocker>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+
+DimensionlessCurveCache::DimensionlessCurveCache(int capacity)
+    : m_capacity(capacity > 0 ? capacity : 1), m_exactHits(0), m_interpolatedHits(0) {}
+
+DimensionlessCurveCache::ParamScale DimensionlessCurveCache::classify(const QString& name)
+{
+    if (name == "q" || name == "B" || name == "h") return PressureScaleParam;
+    if (name == "phi" || name == "Ct") return TimeScaleParam;
+    if (name == "mu" || name == "kf") return PressureTimeScaleParam;
+    return ShapeParam;
+}
+
+QVector<double> DimensionlessCurveCache::paddedTimes(const QVector<double>& tD)
+{
+    double tMin = 0.0, tMax = 0.0;
+    for (double t : tD) {
+        if (t <= 1e-10) continue;
+        if (tMax == 0.0 || t < tMin) tMin = t;
+        if (t > tMax) tMax = t;
+    }
+    if (tMax == 0.0) return tD;
+
+    // 相邻补点比值 √2，两端各外扩 2 倍
+    const double ratio = std::sqrt(2.0);
+    QVector<double> out;
+    out.reserve(tD.size() + 2 * PadPoints);
+    for (int k = PadPoints; k >= 1; --k) out.append(tMin / std::pow(ratio, k));
+    out.append(tD);
+    for (int k = 1; k <= PadPoints; ++k) out.append(tMax * std::pow(ratio, k));
+    return out;
+}
+
+QString DimensionlessCurveCache::shapeKey(const QMap<QString, double>& params)
+{
+    // QMap 按键有序，序列化结果与插入顺序无关
+    QStringList parts;
+    for (auto it = params.constBegin(); it != params.constEnd(); ++it) {
+        if (classify(it.key()) != ShapeParam) continue;
+        if (it.key() == "curveCache" || it.key() == "curveCacheInterp") continue;   // 缓存开关本身不影响曲线
+        parts.append(it.key() + "=" + QString::number(it.value(), 'g', 17));
+    }
+    return parts.join(';');
+}
+
+void DimensionlessCurveCache::buildPchip(Entry& e)
+{
+    e.logT.clear();
+    e.logP.clear();
+    e.slope.clear();
+    e.ratio.clear();
+    e.ratioSlope.clear();
+    const bool withDeriv = (e.DPD.size() == e.PD.size());
+
+    // 1. 正时间点按升序排列，重复时间只保留一个；PD 非正时无法取对数，放弃插值
+    QVector<int> order;
+    for (int i = 0; i < e.tD.size(); ++i) {
+        if (e.tD[i] > 1e-10) order.append(i);
+    }
+    std::sort(order.begin(), order.end(), [&e](int a, int b) { return e.tD[a] < e.tD[b]; });
+    for (int idx : order) {
+        if (!(e.PD[idx] > 0.0)) { e.logT.clear(); e.logP.clear(); e.ratio.clear(); return; }
+        double x = std::log(e.tD[idx]);
+        if (!e.logT.isEmpty() && x <= e.logT.last() + 1e-12) continue;
+        e.logT.append(x);
+        e.logP.append(std::log(e.PD[idx]));
+        if (withDeriv) e.ratio.append(e.DPD[idx] / e.PD[idx]);
+    }
+    if (e.logT.size() < 2) { e.logT.clear(); e.logP.clear(); e.ratio.clear(); return; }
+
+    e.slope = pchipSlopes(e.logT, e.logP);
+    if (withDeriv) e.ratioSlope = pchipSlopes(e.logT, e.ratio);
+}
+
+QVector<double> DimensionlessCurveCache::pchipSlopes(const QVector<double>& x, const QVector<double>& y)
+{
+    int n = x.size();
+
+    // 1. 区间斜率 δ_i
+    QVector<double> h(n - 1), delta(n - 1);
+    for (int i = 0; i < n - 1; ++i) {
+        h[i] = x[i + 1] - x[i];
+        delta[i] = (y[i + 1] - y[i]) / h[i];
+    }
+
+    // 2. 节点导数: 内点取加权调和平均 (相邻斜率异号时为 0)，端点用保形三点公式
+    QVector<double> d(n);
+    if (n == 2) {
+        d[0] = d[1] = delta[0];
+        return d;
+    }
+    for (int i = 1; i < n - 1; ++i) {
+        if (delta[i - 1] * delta[i] <= 0.0) {
+            d[i] = 0.0;
+        } else {
+            double w1 = 2.0 * h[i] + h[i - 1];
+            double w2 = h[i] + 2.0 * h[i - 1];
+            d[i] = (w1 + w2) / (w1 / delta[i - 1] + w2 / delta[i]);
+        }
+    }
+    auto endSlope = [](double h0, double h1, double d0, double d1) {
+        double v = ((2.0 * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+        if (v * d0 <= 0.0) return 0.0;
+        if (d0 * d1 <= 0.0 && std::abs(v) > 3.0 * std::abs(d0)) return 3.0 * d0;
+        return v;
+    };
+    d[0] = endSlope(h[0], h[1], delta[0], delta[1]);
+    d[n - 1] = endSlope(h[n - 2], h[n - 3], delta[n - 2], delta[n - 3]);
+    return d;
+}
+
+double DimensionlessCurveCache::evalHermite(const QVector<double>& x, const QVector<double>& y,
+                                            const QVector<double>& d, double v)
+{
+    // 1. 二分查找所在区间
+    int n = x.size();
+    int i = (int)(std::upper_bound(x.begin(), x.end(), v) - x.begin()) - 1;
+    if (i < 0) i = 0;
+    if (i > n - 2) i = n - 2;
+
+    // 2. 三次 Hermite 基函数
+    double hi = x[i + 1] - x[i];
+    double s = (v - x[i]) / hi;
+    double s2 = s * s, s3 = s2 * s;
+    double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    double h10 = s3 - 2.0 * s2 + s;
+    double h01 = -2.0 * s3 + 3.0 * s2;
+    double h11 = s3 - s2;
+    return h00 * y[i] + h10 * hi * d[i] + h01 * y[i + 1] + h11 * hi * d[i + 1];
+}
+
+bool DimensionlessCurveCache::lookup(const QMap<QString, double>& params, const QVector<double>& tD,
+                                     QVector<double>& outPD, QVector<double>* outDPD, bool allowInterpolation)
+{
+    QString key = shapeKey(params);
+    QMutexLocker locker(&m_mutex);
+
+    for (int k = 0; k < m_entries.size(); ++k) {
+        const Entry& e = m_entries[k];
+        if (e.key != key) continue;
+        if (outDPD && e.DPD.size() != e.PD.size()) return false;
+
+        // 1. 时间点与缓存一致 (缓存两端可能带有补点，按居中对齐比较): 直接复用
+        int extra = e.tD.size() - tD.size();
+        int offset = extra / 2;
+        bool same = (extra >= 0 && extra % 2 == 0);
+        for (int i = 0; same && i < tD.size(); ++i) {
+            same = std::abs(e.tD[offset + i] - tD[i]) <= 1e-12 * std::abs(tD[i]);
+        }
+        if (same) {
+            outPD = e.PD.mid(offset, tD.size());
+            if (outDPD) *outDPD = e.DPD.mid(offset, tD.size());
+            m_exactHits++;
+            m_entries.move(k, 0);
+            return true;
+        }
+
+        // 2. 时间点落在缓存范围内: 双对数 PCHIP 插值
+        if (!allowInterpolation || e.logT.isEmpty()) return false;
+        const double tol = 1e-12;
+        QVector<double> pd(tD.size(), 0.0);
+        QVector<double> dpd(outDPD ? tD.size() : 0, 0.0);
+        for (int i = 0; i < tD.size(); ++i) {
+            if (tD[i] <= 1e-10) continue;
+            double x = std::log(tD[i]);
+            if (x < e.logT.first() - tol || x > e.logT.last() + tol) return false;
+            pd[i] = std::exp(evalHermite(e.logT, e.logP, e.slope, x));
+            if (outDPD) dpd[i] = evalHermite(e.logT, e.ratio, e.ratioSlope, x) * pd[i];
+        }
+        outPD = pd;
+        if (outDPD) *outDPD = dpd;
+        m_interpolatedHits++;
+        m_entries.move(k, 0);
+        return true;
+    }
+    return false;
+}
+
+void DimensionlessCurveCache::insert(const QMap<QString, double>& params, const QVector<double>& tD,
+                                     const QVector<double>& PD, const QVector<double>& DPD)
+{
+    if (tD.size() != PD.size() || tD.isEmpty()) return;
+
+    Entry e;
+    e.key = shapeKey(params);
+    e.tD = tD;
+    e.PD = PD;
+    if (DPD.size() == PD.size()) e.DPD = DPD;
+    buildPchip(e);
+
+    QMutexLocker locker(&m_mutex);
+    for (int k = 0; k < m_entries.size(); ++k) {
+        if (m_entries[k].key == e.key) {
+            m_entries.removeAt(k);
+            break;
+        }
+    }
+    m_entries.prepend(e);
+    while (m_entries.size() > m_capacity) m_entries.removeLast();
+}
+
+void DimensionlessCurveCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+}
+
+int DimensionlessCurveCache::exactHits() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_exactHits;
+}
+
+int DimensionlessCurveCache::interpolatedHits() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_interpolatedHits;
+}
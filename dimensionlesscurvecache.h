@@ -0,0 +1,103 @@
+/*
+ * 文件名: dimensionlesscurvecache.h
+ * 文件作用: 无因次理论曲线缓存头文件
+ * 功能描述:
+ * 1. 按参数对曲线的作用方式分类:
+ *    - 压力尺度参数 (q、B、h): 只进入 p = 1.842e-3*q*mu*B/(kf*h) * PD;
+ *    - 时间尺度参数 (phi、Ct): 只进入 tD = 14.4*kf/(phi*mu*Ct*L^2) * t;
+ *    - 压力兼时间尺度参数 (mu、kf): 同时进入上述两个系数;
+ *    - 形状参数: 其余全部参数 (几何、介质、井储表皮、数值设置等)，决定无因次曲线 PD(tD) 本身。
+ * 2. 以形状参数为键缓存 PD(tD)，最近使用优先 (LRU) 淘汰，缓存曲线两端各外扩 2 倍:
+ *    - tD 与缓存完全一致 (仅压力尺度参数变化): 直接复用，只需乘以新的压力系数;
+ *    - tD 整体平移但落在缓存范围内 (时间尺度参数变化): 在 ln tD - ln PD 上做 PCHIP 保形插值。
+ * 3. 内部加锁，可被拟合雅可比矩阵的并行列计算同时访问。
+ * 4. 供 ModelSolver01_06 与 ModelSolver19_36 的 calculateTheoreticalCurve 共用。
+ * 5. 形状参数键对外公开，批量计算按键分组，同组只完整反演一次。
+ * 6. 可随 PD 一并缓存解析导数 DPD = t·dPD/dt (与时间尺度无关)；插值时对双对数斜率 DPD/PD
+ *    做 PCHIP 插值再乘以插值得到的 PD，请求导数而缓存中没有时视为未命中。
+ * 7. 插值误差随曲线形态而定 (夹层型模型可达 1e-2)，查找时可禁止插值，只接受完全一致的命中；
+ *    求解器缺省不启用缓存 (curveCache=1 时开启)。
+ */
+
+#ifndef DIMENSIONLESSCURVECACHE_H
+#define DIMENSIONLESSCURVECACHE_H
+
+#include <QMap>
+#include <QList>
+#include <QVector>
+#include <QString>
+#include <QMutex>
+
+class DimensionlessCurveCache
+{
+public:
+    // 参数分类
+    enum ParamScale {
+        ShapeParam = 0,          // 形状参数
+        PressureScaleParam,      // 压力尺度参数
+        TimeScaleParam,          // 时间尺度参数
+        PressureTimeScaleParam   // 同时影响压力与时间尺度
+    };
+
+    static ParamScale classify(const QString& name);
+
+    explicit DimensionlessCurveCache(int capacity = 8);
+
+    /**
+     * @brief 查找可复用的无因次曲线
+     * @param params 界面参数 (只取形状参数作为键)
+     * @param tD 本次请求的无因次时间 (tD<=1e-10 的点返回 0)
+     * @param outPD 命中时返回 PD(tD)
+     * @param outDPD 非空时同时返回导数 t·dPD/dt (缓存曲线未带导数时视为未命中)
+     * @param allowInterpolation 为 false 时只接受时间点完全一致的命中
+     * @return 是否命中 (完全一致或可插值)
+     */
+    bool lookup(const QMap<QString, double>& params, const QVector<double>& tD, QVector<double>& outPD,
+                QVector<double>* outDPD = nullptr, bool allowInterpolation = true);
+
+    /**
+     * @brief 生成写入缓存用的计算时间点: 在请求时间点前后各补 PadPoints 个点
+     *        (最小正 tD 除以、最大 tD 乘以 PadRatio 的幂)，使时间尺度参数小幅变化后仍落在插值范围内
+     * @return 扩展后的时间点，前 PadPoints 个与末 PadPoints 个为补点 (无正时间点时原样返回)
+     */
+    static QVector<double> paddedTimes(const QVector<double>& tD);
+    static const int PadPoints = 2;
+
+    // 写入一条完整计算得到的无因次曲线 (同键旧曲线被替换，DPD 为空表示不带导数)
+    void insert(const QMap<QString, double>& params, const QVector<double>& tD, const QVector<double>& PD,
+                const QVector<double>& DPD = QVector<double>());
+
+    void clear();
+
+    // 形状参数键: 键相同的两组参数无因次曲线相同 (批量计算据此合并共用一条曲线)
+    static QString shapeKey(const QMap<QString, double>& params);
+
+    // 命中统计 (直接复用 / 插值复用)
+    int exactHits() const;
+    int interpolatedHits() const;
+
+private:
+    struct Entry {
+        QString key;
+        QVector<double> tD;   // 原始请求顺序
+        QVector<double> PD;
+        QVector<double> DPD;  // 解析导数 t·dPD/dt (可为空)
+        QVector<double> logT; // 升序、去重后的 ln tD (仅 PD>0 时建立，用于插值)
+        QVector<double> logP;
+        QVector<double> slope; // PCHIP 节点导数
+        QVector<double> ratio; // 与 logT 对应的 DPD/PD (双对数斜率)，无导数时为空
+        QVector<double> ratioSlope;
+    };
+
+    static void buildPchip(Entry& e);
+    static QVector<double> pchipSlopes(const QVector<double>& x, const QVector<double>& y);
+    static double evalHermite(const QVector<double>& x, const QVector<double>& y, const QVector<double>& d, double v);
+
+    int m_capacity;
+    QList<Entry> m_entries;   // 表头为最近使用
+    int m_exactHits;
+    int m_interpolatedHits;
+    mutable QMutex m_mutex;
+};
+
+#endif // DIMENSIONLESSCURVECACHE_H
@@ -0,0 +1,114 @@
+/*
+ * 文件名: farfieldquadrature.h
+ * 文件作用: 边界元远场段对的分级积分器 (仅头文件)
+ * 功能描述:
+ * 1. 不同裂缝上两段之间的影响系数为 ∫[-h,h] g(r(a)) da，g(r) = K0(γr) + Ac·I0(γr)，
+ *    r(a) = sqrt(dx² + (dy-a)²)。两段相距越远，被积函数沿积分段越平缓，无需自适应积分。
+ * 2. 按中心距与半段长之比 ρ = r/h 和误差界分级选择积分规则 (由低到高):
+ *    - 中点规则: 2h·f(0)，一次径向函数求值；
+ *    - 局部展开: 在段中心 Taylor 展开到二阶，2h·f(0) + h³/3·f''(0)；
+ *      f'' 由 g、g' 及修正 Helmholtz 方程 g'' = γ²g - g'/r 解析给出，与中点规则共用同一次求值；
+ *    - 3 点 Gauss-Legendre 规则 (代数精度 5)；
+ *    - 自适应 Gauss-Kronrod (近场或以上误差界均不满足时)。
+ * 3. 误差界: 以二阶项的幅值 h³/3·F2 作为中点规则误差，F2 = |γ²g|·dy²/r² + |g'|·|dx² - dy²|/r³
+ *    为 f'' 两部分绝对值之和 (f'' 本身可能因两项抵消而接近 0，不能直接作为误差估计)，高阶导数按
+ *    |f⁽ⁿ⁾| ≈ F2·[(n!/2)/R^(n-2) + |γ|^(n-2)] 估计 (R = r - h 为段到源点的最近距离下界，
+ *    前者对应 r=0 处的奇异性，后者对应指数型衰减/增长)，
+ *    估计误差 < tierTol·(|2h·g| + 2h) 时接受 (以段长为绝对尺度)。
+ *    Gauss-Kronrod 的 |K15 - G7| 误差估计远比实际误差保守，直接套用其容差会使低阶规则过粗
+ *    (Stehfest 反演放大 Laplace 解误差约 1e4 倍)，因此 tierTol 单独给定。
+ * 4. 实数 (Stehfest) 与复数 (Talbot / de Hoog) 被积函数共用模板实现；
+ *    每个段对实际采用的级别累加到统计信息中，供求解器输出。
+ */
+
+#ifndef FARFIELDQUADRATURE_H
+#define FARFIELDQUADRATURE_H
+
+#include <cmath>
+#include <complex>
+
+#include "gausskronrod.h"
+
+class FarFieldQuadrature
+{
+public:
+    // 积分级别 (Truncated 为调用方按截断半径直接置零的段对)
+    enum Tier { Truncated = 0, Midpoint, Expansion, Gauss3, Adaptive, TierCount };
+
+    // 各级别的段对计数 (可跨多次积分累加)
+    struct Stats
+    {
+        long long pairs[TierCount] = { 0, 0, 0, 0, 0 };
+    };
+
+    // ρ = r/h 低于该值时段与源点过近，展开不再可靠，直接使用自适应积分
+    static constexpr double MinRatio = 2.0;
+
+    /**
+     * @brief 分级积分 ∫[-h,h] g(sqrt(dx² + (dy-a)²)) da
+     * @param gamma 径向函数中的 γ (实数或复数)
+     * @param tierTol 前三级规则的误差界容差: 估计误差 < tierTol·(|2h·g(r)| + 2h) 时接受
+     * @param eps, maxDepth 退回自适应积分时的 Gauss-Kronrod 容差与最大二分层数
+     * @param radial 径向函数 void radial(double r, T& g, T& dg)，返回 g(r) 与 g'(r)
+     * @param panel 面板批量被积函数 void panel(const double* a, T* out, int n)，用于 3 点规则与自适应积分
+     */
+    template <typename T, typename Radial, typename Panel>
+    static T integrate(double dx, double dy, double h, const T& gamma, double tierTol, double eps, int maxDepth,
+                       Radial&& radial, Panel&& panel, Stats* stats = nullptr,
+                       GaussKronrodStats* quad = nullptr)
+    {
+        const double r = std::sqrt(dx * dx + dy * dy);
+        if (!(r >= MinRatio * h)) {
+            if (stats) stats->pairs[Adaptive]++;
+            return GaussKronrod::integrateBatch<T>(panel, -h, h, eps, maxDepth, quad);
+        }
+
+        // 段中心处的 g、g' 与沿积分段的二阶导数 f''(0) (两部分分开，便于估计幅值)
+        T g, dg;
+        radial(r, g, dg);
+        if (quad) quad->evaluations += 1;
+        const double r2 = r * r;
+        const T f2a = gamma * gamma * g * (dy * dy / r2);
+        const T f2b = dg * ((dx * dx - dy * dy) / (r2 * r));
+
+        const T mid = 2.0 * h * g;
+        const T corr = (h * h * h / 3.0) * (f2a + f2b);
+        const double corrAbs = (h * h * h / 3.0) * (std::abs(f2a) + std::abs(f2b));
+        const double tol = tierTol * (std::abs(mid) + 2.0 * h);
+
+        // 1. 中点规则: 误差即二阶项
+        if (!(corrAbs >= tol)) {
+            if (stats) stats->pairs[Midpoint]++;
+            return mid;
+        }
+
+        const double R = r - h;
+        const double gAbs = std::abs(gamma);
+        const double h2 = h * h;
+
+        // 2. 局部展开: 余项 2h·h⁴/120·f⁽⁴⁾ = (h³/3·F2)·h²·(f⁽⁴⁾/F2)/20
+        const double errExpansion = corrAbs * h2 * (12.0 / (R * R) + gAbs * gAbs) / 20.0;
+        if (errExpansion < tol) {
+            if (stats) stats->pairs[Expansion]++;
+            return mid + corr;
+        }
+
+        // 3. 3 点 Gauss: 余项 (2h)⁷(3!)⁴/(7·(6!)³)·f⁽⁶⁾ ≈ 6.349e-5·h⁷·f⁽⁶⁾，相对二阶项幅值 h³/3·F2 之比
+        const double errGauss3 = corrAbs * 1.9047e-4 * h2 * h2 * (360.0 / (R * R * R * R) + gAbs * gAbs * gAbs * gAbs);
+        if (errGauss3 < tol) {
+            static const double node = 0.774596669241483377035853079956480;  // sqrt(3/5)
+            double a[3] = { -node * h, 0.0, node * h };
+            T y[3];
+            panel(a, y, 3);
+            if (quad) quad->evaluations += 3;
+            if (stats) stats->pairs[Gauss3]++;
+            return h * ((5.0 / 9.0) * (y[0] + y[2]) + (8.0 / 9.0) * y[1]);
+        }
+
+        // 4. 以上误差界均不满足: 自适应积分
+        if (stats) stats->pairs[Adaptive]++;
+        return GaussKronrod::integrateBatch<T>(panel, -h, h, eps, maxDepth, quad);
+    }
+};
+
+#endif // FARFIELDQUADRATURE_H
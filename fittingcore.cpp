@@ -1,18 +1,53 @@
 /*
  * 文件名: fittingcore.cpp
  * 文件作用: 试井拟合核心算法实现
+ * 功能描述:
+ * 1. 雅可比矩阵优先使用模型给出的解析灵敏度 (一次求值得到全部可求导参数的列)，
+ *    不可解析求导的参数 (裂缝条数等整数参数、复变量反演、Bourdet 导数模式) 仍按扰动曲线中心差分。
+ * 2. 参数字典中 analyticJacobian=0 时全部列使用中心差分。
+ * 3. Broyden 模式: 接受的步对雅可比矩阵做秩一更新，仅在步被拒绝、进展停滞或每隔若干次迭代时完整重算；
+ *    每次拟合结束输出各类曲线求值次数，便于比较两种模式。
+ * 4. 迭代过程中的显示曲线复用残差计算的理论曲线，每次迭代不再额外求解；拟合结束时显示的也是最高保真度下
+ *    最终参数的残差曲线 (与报告的误差一致)，仅无观测数据时按默认时间序列单独计算。
+ *    求解精度只由参数字典 (保真度阶梯) 决定，拟合不再切换 ModelManager 的全局精度开关。
+ * 5. 保真度阶梯: Stehfest 阶数、裂缝离散段数、积分容差与抽样点数分级，前期迭代用最廉价的一级，
+ *    均方误差的改进量低于本级误差或步长很小时升级；各级的误差、迭代次数与耗时输出到拟合日志。
+ *    本级误差在进入本级及每次完整重算雅可比时按当前参数重新测量；迭代次数为最高级保留最少 TopLevelMinIterations 次。
+ * 6. 全局搜索: 起点为当前参数加拉丁超立方样本 (差分进化模式下先以样本为初始种群进化若干代)，
+ *    各起点在最低保真度下分轮并行迭代，每轮后淘汰误差远大于当前最优的起点；残差按参数字典缓存，
+ *    各起点与进化个体共享。候选解排序后输出到拟合日志，最优解作为初值交给正常拟合流程。
+ *    局部步截断到无效值时加大阻尼重试；单位超立方体映射与 LM 步长共用同一对数尺度判定 (isLogScale)。
+ * 7. 停止标志为原子变量，界面线程置位，拟合线程与全局搜索的并行任务读取。
+ * 8. 保真度阶梯放宽了远场分级或渐近捷径容差的级别 (粗、中) 雅可比矩阵全部列使用中心差分:
+ *    解析灵敏度按稠密组装、逐段自适应积分求取，不走分级积分与渐近捷径，与这两级的残差曲线不一致。
  */
 
 #include "fittingcore.h"
 #include "modelparameter.h" // 引入模型参数单例
+#include "taskscheduler.h"
 #include <QtConcurrent>
 #include <cmath>
 #include <numeric>
 #include <algorithm>
 #include <Eigen/Dense>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <limits>
+
+// 拟合保真度阶梯: 前期用廉价设置快速接近解，逐级提高，最后一级为用户设置 (不做任何覆盖)；
+// 粗、中两级实际放宽了远场/渐近容差时雅可比改用中心差分 (见 applyFidelity)
+const FittingCore::FidelityLevel FittingCore::FidelityLadder[FittingCore::FidelityLevelCount] = {
+    // 名称   N   段数比例  远场容差  渐近容差  抽样点上限
+    { "粗",   6,  0.5,     1e-8,     1e-6,     40 },
+    { "中",   8,  0.75,    1e-9,     1e-8,     100 },
+    { "精",   0,  1.0,     0.0,      0.0,      0 },
+};
 
 FittingCore::FittingCore(QObject *parent)
-    : QObject(parent), m_modelManager(nullptr), m_isCustomSamplingEnabled(false), m_stopRequested(false)
+    : QObject(parent), m_modelManager(nullptr), m_isCustomSamplingEnabled(false), m_stopRequested(false),
+      m_broydenUpdates(true), m_jacobianRefresh(5), m_fidelityLadder(true),
+      m_globalSearch(false), m_globalStarts(8), m_globalExploration(LatinHypercube)
 {
     // 监听异步任务完成
     connect(&m_watcher, &QFutureWatcher<void>::finished, this, &FittingCore::sigFitFinished);
@@ -47,6 +82,29 @@ void FittingCore::stopFit() {
     m_stopRequested = true;
 }
 
+void FittingCore::setJacobianUpdate(bool broyden, int refreshInterval) {
+    m_broydenUpdates = broyden;
+    m_jacobianRefresh = qMax(1, refreshInterval);
+}
+
+void FittingCore::setFidelityLadder(bool enabled) {
+    m_fidelityLadder = enabled;
+}
+
+void FittingCore::setGlobalSearch(bool enabled, int starts, GlobalExploration exploration) {
+    m_globalSearch = enabled;
+    m_globalStarts = qMax(1, starts);
+    m_globalExploration = exploration;
+}
+
+FittingCore::FitStats FittingCore::lastFitStats() const {
+    return m_fitStats;
+}
+
+QVector<FittingCore::GlobalCandidate> FittingCore::lastGlobalCandidates() const {
+    return m_globalCandidates;
+}
+
 void FittingCore::getLogSampledData(const QVector<double>& srcT, const QVector<double>& srcP, const QVector<double>& srcD,
                                     QVector<double>& outT, QVector<double>& outP, QVector<double>& outD)
 {
@@ -229,12 +287,20 @@ QMap<QString, double> FittingCore::preprocessParams(const QMap<QString, double>&
 }
 
 void FittingCore::runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight) {
+    m_fitStats = FitStats();
+    m_globalCandidates.clear();
+
+    // 全局搜索的最优候选作为初值，其后的保真度阶梯、界面刷新与最终曲线与普通拟合相同
+    if (m_globalSearch && m_globalStarts > 1 && runGlobalSearch(modelType, fitParams, weight)) {
+        const QMap<QString, double>& best = m_globalCandidates.first().params;
+        for (FitParameter& p : fitParams) {
+            if (p.isFit && best.contains(p.name)) p.value = best.value(p.name);
+        }
+    }
     runLevenbergMarquardtOptimization(modelType, fitParams, weight);
 }
 
 void FittingCore::runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight) {
-    if(m_modelManager) m_modelManager->setHighPrecision(false);
-
     QVector<int> fitIndices;
     for(int i=0; i<params.size(); ++i) {
         if(params[i].isFit && params[i].name != "LfD") fitIndices.append(i);
@@ -244,17 +310,66 @@ void FittingCore::runLevenbergMarquardtOptimization(ModelManager::ModelType mode
     QMap<QString, double> currentParamMap;
     for(const auto& p : params) currentParamMap.insert(p.name, p.value);
 
-    // [关键] 使用预处理后的参数进行初始计算
-    QMap<QString, double> solverParams = preprocessParams(currentParamMap, modelType);
+    QVector<double> allT, allP, allD;
+    getLogSampledData(m_obsTime, m_obsDeltaP, m_obsDerivative, allT, allP, allD);
+    QStringList fittedNames;
+    for (int idx : fitIndices) fittedNames.append(params[idx].name);
+
+    // 迭代过程中的显示曲线直接取残差计算所用的理论曲线 (抽样时间点)，不再为显示单独求解；
+    // 没有观测数据时残差为空，才按默认时间序列单独计算一次
+    auto emitIteration = [&](double sse, const QMap<QString, double>& paramMap, const ModelCurveData& residualCurve, int nRes) {
+        if (std::get<0>(residualCurve).isEmpty()) {
+            ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, preprocessParams(paramMap, modelType));
+            m_fitStats.displayCurves++;
+            emit sigIterationUpdated(sse/nRes, paramMap, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+            return;
+        }
+        emit sigIterationUpdated(sse/nRes, paramMap, std::get<0>(residualCurve), std::get<1>(residualCurve), std::get<2>(residualCurve));
+    };
 
+    // 保真度阶梯: 从最廉价的一级开始 (未开启阶梯或无拟合参数时直接使用最高级)，
+    // 进入每一级时在本级抽样点上重算残差；本级误差为当前参数下本级与最高级残差之差的均方根
+    const int topLevel = FidelityLevelCount - 1;
+    int level = (m_fidelityLadder && nParams > 0) ? 0 : topLevel;
     QVector<double> fitT, fitP, fitD;
-    getLogSampledData(m_obsTime, m_obsDeltaP, m_obsDerivative, fitT, fitP, fitD);
-
-    QVector<double> residuals = calculateResiduals(currentParamMap, modelType, weight, fitT, fitP, fitD);
-    double currentSSE = calculateSumSquaredError(residuals);
-
-    ModelCurveData curve = m_modelManager->calculateTheoreticalCurve(modelType, solverParams);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(curve), std::get<1>(curve), std::get<2>(curve));
+    QVector<double> residuals;
+    double currentSSE = 0.0;
+    ModelCurveData currentCurve;    // 当前参数在本级保真度下的残差曲线 (显示用)
+    double levelError = 0.0;
+    QElapsedTimer levelTimer;
+    auto levelParams = [&](const QMap<QString, double>& raw) { return applyFidelity(raw, level, fittedNames); };
+    // 本级误差随参数变化 (如表皮、储集改变了早期段的反演难度)，进入本级与每次完整重算雅可比时重新测量，
+    // 统计中记录本级测得的最大值
+    auto measureLevelError = [&]() {
+        if (level >= topLevel || residuals.isEmpty()) return;
+        QVector<double> reference = calculateResiduals(applyFidelity(currentParamMap, topLevel, fittedNames), modelType,
+                                                       weight, fitT, fitP, fitD);
+        m_fitStats.residualCurves++;
+        if (reference.size() != residuals.size()) return;
+        double sum = 0.0;
+        for (int k = 0; k < residuals.size(); ++k) sum += (residuals[k] - reference[k]) * (residuals[k] - reference[k]);
+        levelError = std::sqrt(sum / residuals.size());
+        m_fitStats.levels.last().error = qMax(m_fitStats.levels.last().error, levelError);
+    };
+    auto startLevel = [&]() {
+        fitT = allT; fitP = allP; fitD = allD;
+        subsampleData(FidelityLadder[level].maxSamples, fitT, fitP, fitD);
+        levelTimer.start();
+        residuals = calculateResiduals(levelParams(currentParamMap), modelType, weight, fitT, fitP, fitD, &currentCurve);
+        m_fitStats.residualCurves++;
+        currentSSE = calculateSumSquaredError(residuals);
+        levelError = 0.0;
+        FitStats::Level stats;
+        stats.name = QString::fromUtf8(FidelityLadder[level].name);
+        stats.samples = fitT.size();
+        m_fitStats.levels.append(stats);
+        measureLevelError();
+        emitIteration(currentSSE, currentParamMap, currentCurve, residuals.size());
+    };
+    auto finishLevel = [&]() {
+        if (!m_fitStats.levels.isEmpty()) m_fitStats.levels.last().milliseconds = levelTimer.elapsed();
+    };
+    startLevel();
 
     if(nParams == 0) {
         emit sigFitFinished();
@@ -264,31 +379,63 @@ void FittingCore::runLevenbergMarquardtOptimization(ModelManager::ModelType mode
     double lambda = 0.01;
     int maxIter = 50;
 
+    // 雅可比矩阵: Broyden 模式下接受的步只做秩一更新，以下情况重新完整计算:
+    // 首次迭代、近似雅可比给出的步被拒绝、SSE 相对下降低于 StallRatio、距上次完整计算已满 m_jacobianRefresh 次迭代
+    const double StallRatio = 0.01;
+    // 保真度升级的参数步长阈值 (拟合变量空间，对数参数为 log10 值)
+    const double LevelStepTol = 1e-3;
+    // 最高级至少保留的迭代次数: 剩余次数降到此值时无论本级是否用尽都升到最高级
+    const int TopLevelMinIterations = qMin(10, maxIter / 2);
+    QVector<QVector<double>> J;
+    bool needFullJacobian = true;
+    bool jacobianFresh = false;
+    int sinceFull = 0;
+
+    // 切换保真度级别: 残差的长度与含义改变，雅可比矩阵与阻尼重新开始
+    auto enterLevel = [&](int next) {
+        finishLevel();
+        level = next;
+        startLevel();
+        needFullJacobian = true;
+        lambda = 0.01;
+    };
+    // 升级到下一级保真度 (已是最高级时返回 false)
+    auto escalate = [&]() {
+        if (level >= topLevel) return false;
+        enterLevel(level + 1);
+        return true;
+    };
+
     for(int iter = 0; iter < maxIter; ++iter) {
         if(m_stopRequested) break;
-        if (!residuals.isEmpty() && (currentSSE / residuals.size()) < 3e-3) break;
+        if (level < topLevel && maxIter - iter <= TopLevelMinIterations) enterLevel(topLevel);
+        if (!residuals.isEmpty() && (currentSSE / residuals.size()) < 3e-3) {
+            // 低保真度下达到收敛标准时先升级复核，只有最高级的结果才作为收敛
+            if (escalate()) continue;
+            break;
+        }
 
         emit sigProgress(iter * 100 / maxIter);
+        m_fitStats.iterations++;
+        m_fitStats.levels.last().iterations++;
 
-        QVector<QVector<double>> J = computeJacobian(currentParamMap, residuals, fitIndices, modelType, params, weight, fitT, fitP, fitD);
         int nRes = residuals.size();
-
-        QVector<QVector<double>> H(nParams, QVector<double>(nParams, 0.0));
-        QVector<double> g(nParams, 0.0);
-
-        for(int k=0; k<nRes; ++k) {
-            for(int i=0; i<nParams; ++i) {
-                g[i] += J[k][i] * residuals[k];
-                for(int j=0; j<=i; ++j) {
-                    H[i][j] += J[k][i] * J[k][j];
-                }
-            }
-        }
-        for(int i=0; i<nParams; ++i) {
-            for(int j=i+1; j<nParams; ++j) H[i][j] = H[j][i];
+        if (!m_broydenUpdates || needFullJacobian || J.size() != nRes || sinceFull >= m_jacobianRefresh) {
+            J = computeJacobian(levelParams(currentParamMap), residuals, fitIndices, modelType, params, weight, fitT, fitP, fitD,
+                                m_fitStats);
+            m_fitStats.fullJacobians++;
+            needFullJacobian = false;
+            jacobianFresh = true;
+            sinceFull = 0;
+            measureLevelError();
         }
 
+        QVector<QVector<double>> H;
+        QVector<double> g;
+        normalEquations(J, residuals, nParams, H, g);
+
         bool stepAccepted = false;
+        bool levelExhausted = false;
         for(int tryIter=0; tryIter<5; ++tryIter) {
             QVector<QVector<double>> H_lm = H;
             for(int i=0; i<nParams; ++i) H_lm[i][i] += lambda * (1.0 + std::abs(H[i][i]));
@@ -297,58 +444,520 @@ void FittingCore::runLevenbergMarquardtOptimization(ModelManager::ModelType mode
             for(int i=0;i<nParams;++i) negG[i] = -g[i];
 
             QVector<double> delta = solveLinearSystem(H_lm, negG);
-            QMap<QString, double> trialMap = currentParamMap;
-
-            for(int i=0; i<nParams; ++i) {
-                int pIdx = fitIndices[i];
-                QString pName = params[pIdx].name;
-                double oldVal = currentParamMap[pName];
-                bool isLog = (oldVal > 1e-12 && pName != "S" && pName != "nf");
-                double newVal;
-                if(isLog) newVal = pow(10.0, log10(oldVal) + delta[i]);
-                else newVal = oldVal + delta[i];
-                newVal = qMax(params[pIdx].min, qMin(newVal, params[pIdx].max));
-                trialMap[pName] = newVal;
+            QMap<QString, double> trialMap;
+            // 截断到上下限后实际走过的步长 (与雅可比同一变量空间: 对数参数为 log10 值)
+            QVector<double> appliedStep;
+            // 对数参数被截断到非正的下限时该步无效，与全局搜索的局部迭代相同: 加大阻尼缩短步长重试
+            if (!stepParams(currentParamMap, params, fitIndices, delta, trialMap, appliedStep)) {
+                lambda *= 10.0;
+                continue;
             }
 
             // [关键] 内部会自动调用 preprocessParams
-            QVector<double> newRes = calculateResiduals(trialMap, modelType, weight, fitT, fitP, fitD);
+            ModelCurveData trialCurve;
+            QVector<double> newRes = calculateResiduals(levelParams(trialMap), modelType, weight, fitT, fitP, fitD, &trialCurve);
+            m_fitStats.residualCurves++;
             double newSSE = calculateSumSquaredError(newRes);
 
             if(newSSE < currentSSE) {
+                // 秩一更新: J += (Δr - J·s)·sᵀ / (sᵀs)，使 J 满足本步的割线条件
+                if (m_broydenUpdates) {
+                    if (broydenUpdate(J, appliedStep, residuals, newRes)) {
+                        m_fitStats.broydenUpdates++;
+                        jacobianFresh = false;
+                        sinceFull++;
+                    } else {
+                        needFullJacobian = true;
+                    }
+                    if (currentSSE - newSSE < StallRatio * currentSSE) needFullJacobian = true;
+                }
+
+                // 保真度: 每点均方误差的改进量已不超过本级误差可能造成的变化 (2·rms·e + e²)，
+                // 或参数步长已很小时，继续在本级迭代没有意义，升级到下一级
+                if (level < topLevel) {
+                    double mse = currentSSE / nRes;
+                    double gain = (currentSSE - newSSE) / nRes;
+                    double maxStep = 0.0;
+                    for (double s : appliedStep) maxStep = qMax(maxStep, std::abs(s));
+                    if (gain < 2.0 * std::sqrt(mse) * levelError + levelError * levelError || maxStep < LevelStepTol) {
+                        levelExhausted = true;
+                    }
+                }
+
                 currentSSE = newSSE;
                 currentParamMap = trialMap;
                 residuals = newRes;
+                currentCurve = trialCurve;
                 lambda /= 10.0;
                 stepAccepted = true;
 
-                // 更新曲线
-                QMap<QString, double> trialSolverParams = preprocessParams(trialMap, modelType);
-                ModelCurveData iterCurve = m_modelManager->calculateTheoreticalCurve(modelType, trialSolverParams);
-                emit sigIterationUpdated(currentSSE/nRes, currentParamMap, std::get<0>(iterCurve), std::get<1>(iterCurve), std::get<2>(iterCurve));
+                // 更新曲线 (即本次试探步的残差曲线)
+                emitIteration(currentSSE, currentParamMap, trialCurve, nRes);
+                break;
+            } else if (!jacobianFresh) {
+                // 近似雅可比给出的步被拒绝: 不增大阻尼，下一次迭代以完整雅可比重新求步
+                needFullJacobian = true;
                 break;
             } else {
                 lambda *= 10.0;
             }
         }
+        // 完整雅可比下本级已找不到下降方向时同样升级
+        if (!stepAccepted && jacobianFresh && level < topLevel) levelExhausted = true;
+        if (levelExhausted && escalate()) continue;
         if(!stepAccepted && lambda > 1e10) break;
     }
 
-    if(m_modelManager) m_modelManager->setHighPrecision(true);
+    // 迭代次数用尽或中途停止时仍处于低保真度: 以最高级重算残差，报告的误差与最终曲线一致
+    if (level < topLevel) {
+        finishLevel();
+        level = topLevel;
+        startLevel();
+    }
+    finishLevel();
+
+    // 最终曲线即最高级保真度下最终参数的残差曲线 (求解器精度由参数字典决定，与报告的误差同一次求值)，
+    // 无观测数据时 emitIteration 按默认时间序列计算
+    emitIteration(currentSSE, currentParamMap, currentCurve, residuals.size());
+
+    qDebug() << "拟合求值统计 [" << (m_broydenUpdates ? "Broyden" : "完整雅可比") << "]: 迭代" << m_fitStats.iterations
+             << "次, 残差曲线" << m_fitStats.residualCurves << "条, 雅可比完整计算" << m_fitStats.fullJacobians
+             << "次 (扰动曲线" << m_fitStats.jacobianCurves << "条, 解析灵敏度" << m_fitStats.sensitivityPasses
+             << "次), Broyden 更新" << m_fitStats.broydenUpdates << "次, 显示曲线" << m_fitStats.displayCurves << "条";
+    for (const FitStats::Level& stats : m_fitStats.levels) {
+        qDebug() << "保真度阶梯 [" << stats.name << "]: 抽样点" << stats.samples << "个, 本级误差" << stats.error
+                 << ", 迭代" << stats.iterations << "次, 耗时" << stats.milliseconds << "ms";
+    }
+}
+
+bool FittingCore::runGlobalSearch(ModelManager::ModelType modelType, const QList<FitParameter>& params, double weight) {
+    if (!m_modelManager) return false;
+    QVector<int> fitIndices;
+    QStringList fittedNames;
+    for (int i = 0; i < params.size(); ++i) {
+        if (params[i].isFit && params[i].name != "LfD") {
+            fitIndices.append(i);
+            fittedNames.append(params[i].name);
+        }
+    }
+    int nParams = fitIndices.size();
+    if (nParams == 0) return false;
+
+    // 起点数、每轮迭代次数与淘汰标准: 每轮后误差超过当前最优 PruneRatio 倍且不在前 keep 名的起点停止迭代
+    const int starts = m_globalStarts;
+    const int RoundIterations = 3;
+    const int MaxRounds = 6;
+    const double PruneRatio = 4.0;
+    const int keep = qMax(2, (starts + 3) / 4);
+    const double ConvergedMSE = 3e-3;       // 与局部拟合的收敛标准一致
+    const double DuplicateTol = 0.01;       // 单位超立方体中各坐标差均小于此值视为同一位置
+    // 差分进化: DE/rand/1/bin，种群为起点数的 2 倍
+    const int DeGenerations = 10;
+    const double DeWeight = 0.7;
+    const double DeCrossover = 0.9;
+
+    // 1. 全局阶段统一使用最低一级保真度 (未开启阶梯时为用户设置) 及其抽样点
+    const int level = m_fidelityLadder ? 0 : FidelityLevelCount - 1;
+    QVector<double> fitT, fitP, fitD;
+    getLogSampledData(m_obsTime, m_obsDeltaP, m_obsDerivative, fitT, fitP, fitD);
+    subsampleData(FidelityLadder[level].maxSamples, fitT, fitP, fitD);
+    if (fitT.isEmpty()) return false;
+    {
+        QMutexLocker locker(&m_residualCacheMutex);
+        m_residualCache.clear();
+    }
+
+    QMap<QString, double> baseMap;
+    for (const auto& p : params) baseMap.insert(p.name, p.value);
+    auto mapFromUnit = [&](const QVector<double>& u) {
+        QMap<QString, double> map = baseMap;
+        for (int j = 0; j < nParams; ++j) map[params[fitIndices[j]].name] = fromUnit(params[fitIndices[j]], u[j]);
+        return map;
+    };
+    auto evaluate = [&](const QMap<QString, double>& raw, FitStats& stats) {
+        return cachedResiduals(applyFidelity(raw, level, fittedNames), modelType, weight, fitT, fitP, fitD, stats);
+    };
+    auto mseOf = [&](const QVector<double>& residuals) {
+        if (residuals.isEmpty()) return std::numeric_limits<double>::infinity();
+        return calculateSumSquaredError(residuals) / residuals.size();
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    // 固定种子: 同一数据、同一初值的全局搜索结果可重现
+    std::mt19937 rng(20240611u);
+
+    // 2. 起点: 当前参数 + 拉丁超立方样本；差分进化模式下样本作为初始种群，进化后取最优的 starts 个个体
+    QVector<QVector<double>> seeds;
+    QVector<double> userUnit(nParams);
+    for (int j = 0; j < nParams; ++j) userUnit[j] = toUnit(params[fitIndices[j]], params[fitIndices[j]].value);
+    seeds.append(userUnit);
+    bool evolve = (m_globalExploration == DifferentialEvolution);
+    int population = evolve ? qMax(2 * starts, 8) : starts;
+    seeds += latinHypercube(nParams, population - 1, rng);
+
+    QVector<FitStats> exploreStats(population);
+    if (evolve) {
+        auto evaluateAll = [&](const QVector<QVector<double>>& members, QVector<double>& fitness) {
+            fitness.resize(members.size());
+            TaskScheduler::instance().parallelFor(members.size(), [&](int i) {
+                fitness[i] = mseOf(evaluate(mapFromUnit(members[i]), exploreStats[i]));
+            });
+        };
+        QVector<double> fitness, trialFitness;
+        evaluateAll(seeds, fitness);
+        std::uniform_int_distribution<int> pick(0, population - 1);
+        std::uniform_int_distribution<int> pickDim(0, nParams - 1);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        for (int gen = 0; gen < DeGenerations && !m_stopRequested; ++gen) {
+            emit sigProgress(gen * 100 / DeGenerations);
+            QVector<QVector<double>> trials(population);
+            for (int i = 0; i < population; ++i) {
+                int a, b, c;
+                do { a = pick(rng); } while (a == i);
+                do { b = pick(rng); } while (b == i || b == a);
+                do { c = pick(rng); } while (c == i || c == a || c == b);
+                int forced = pickDim(rng);
+                trials[i] = seeds[i];
+                for (int j = 0; j < nParams; ++j) {
+                    if (j == forced || unit(rng) < DeCrossover) {
+                        trials[i][j] = qBound(0.0, seeds[a][j] + DeWeight * (seeds[b][j] - seeds[c][j]), 1.0);
+                    }
+                }
+            }
+            evaluateAll(trials, trialFitness);
+            for (int i = 0; i < population; ++i) {
+                if (trialFitness[i] <= fitness[i]) {
+                    seeds[i] = trials[i];
+                    fitness[i] = trialFitness[i];
+                }
+            }
+        }
+        QVector<int> order(population);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int x, int y) { return fitness[x] < fitness[y]; });
+        QVector<QVector<double>> best;
+        for (int k = 0; k < starts; ++k) best.append(seeds[order[k]]);
+        seeds = best;
+    }
+
+    // 3. 各起点的局部 LM (完整雅可比，不做 Broyden 更新与保真度升级)，分轮并行，起点内部的曲线求值嵌套在同一调度器中
+    struct Start
+    {
+        QMap<QString, double> params;
+        QVector<double> residuals;
+        double sse = 0.0;
+        double lambda = 0.01;
+        int iterations = 0;
+        bool active = true;
+        bool pruned = false;
+        FitStats stats;
+        double mse() const {
+            return residuals.isEmpty() ? std::numeric_limits<double>::infinity() : sse / residuals.size();
+        }
+    };
+    QVector<Start> runs(seeds.size());
+    TaskScheduler::instance().parallelFor(runs.size(), [&](int k) {
+        Start& s = runs[k];
+        s.params = mapFromUnit(seeds[k]);
+        s.residuals = evaluate(s.params, s.stats);
+        s.sse = calculateSumSquaredError(s.residuals);
+        s.active = !s.residuals.isEmpty();
+    });
+
+    auto iterate = [&](Start& s) {
+        if (s.mse() < ConvergedMSE) {
+            s.active = false;
+            return;
+        }
+        s.iterations++;
+        int nRes = s.residuals.size();
+        QVector<QVector<double>> J = computeJacobian(applyFidelity(s.params, level, fittedNames), s.residuals, fitIndices,
+                                                     modelType, params, weight, fitT, fitP, fitD, s.stats);
+        s.stats.fullJacobians++;
+        QVector<QVector<double>> H;
+        QVector<double> g;
+        normalEquations(J, s.residuals, nParams, H, g);
+        for (int tryIter = 0; tryIter < 5; ++tryIter) {
+            QVector<QVector<double>> H_lm = H;
+            QVector<double> negG(nParams);
+            for (int i = 0; i < nParams; ++i) {
+                H_lm[i][i] += s.lambda * (1.0 + std::abs(H[i][i]));
+                negG[i] = -g[i];
+            }
+            QMap<QString, double> trialMap;
+            QVector<double> appliedStep;
+            // 对数参数被截断到非正的下限时该步无效，加大阻尼缩短步长重试
+            if (!stepParams(s.params, params, fitIndices, solveLinearSystem(H_lm, negG), trialMap, appliedStep)) {
+                s.lambda *= 10.0;
+                continue;
+            }
+            QVector<double> newRes = evaluate(trialMap, s.stats);
+            double newSSE = calculateSumSquaredError(newRes);
+            if (newRes.size() == nRes && newSSE < s.sse) {
+                s.params = trialMap;
+                s.residuals = newRes;
+                s.sse = newSSE;
+                s.lambda /= 10.0;
+                return;
+            }
+            s.lambda *= 10.0;
+        }
+        if (s.lambda > 1e10) s.active = false;
+    };
+
+    for (int round = 0; round < MaxRounds && !m_stopRequested; ++round) {
+        QVector<int> active;
+        for (int k = 0; k < runs.size(); ++k) {
+            if (runs[k].active) active.append(k);
+        }
+        if (active.isEmpty()) break;
+        emit sigProgress(round * 100 / MaxRounds);
+        TaskScheduler::instance().parallelFor(active.size(), [&](int a) {
+            Start& s = runs[active[a]];
+            for (int it = 0; it < RoundIterations && s.active && !m_stopRequested; ++it) iterate(s);
+        });
+
+        QVector<int> order(runs.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int x, int y) { return runs[x].mse() < runs[y].mse(); });
+        double bestMse = runs[order[0]].mse();
+        for (int rank = keep; rank < order.size(); ++rank) {
+            Start& s = runs[order[rank]];
+            if (s.active && s.mse() > PruneRatio * bestMse) {
+                s.active = false;
+                s.pruned = true;
+            }
+        }
+    }
+
+    // 4. 候选解按误差排序，与更优候选位置相同的标记为重复
+    QVector<int> order(runs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int x, int y) { return runs[x].mse() < runs[y].mse(); });
+    QVector<QVector<double>> distinct;
+    for (int k : order) {
+        const Start& s = runs[k];
+        if (s.residuals.isEmpty()) continue;
+        GlobalCandidate candidate;
+        candidate.params = s.params;
+        candidate.mse = s.mse();
+        candidate.iterations = s.iterations;
+        candidate.pruned = s.pruned;
+        QVector<double> u(nParams);
+        for (int j = 0; j < nParams; ++j) u[j] = toUnit(params[fitIndices[j]], s.params.value(params[fitIndices[j]].name));
+        for (const QVector<double>& other : distinct) {
+            double distance = 0.0;
+            for (int j = 0; j < nParams; ++j) distance = qMax(distance, std::abs(u[j] - other[j]));
+            if (distance < DuplicateTol) candidate.duplicate = true;
+        }
+        if (!candidate.duplicate) distinct.append(u);
+        m_globalCandidates.append(candidate);
+    }
+
+    // 5. 统计与日志
+    auto absorb = [&](const FitStats& stats) {
+        m_fitStats.globalCurves += stats.residualCurves + stats.jacobianCurves;
+        m_fitStats.globalSensitivityPasses += stats.sensitivityPasses;
+        m_fitStats.cacheHits += stats.cacheHits;
+    };
+    for (const FitStats& stats : exploreStats) absorb(stats);
+    for (const Start& s : runs) {
+        absorb(s.stats);
+        if (s.pruned) m_fitStats.globalPruned++;
+    }
+    m_fitStats.globalStarts = runs.size();
+    {
+        QMutexLocker locker(&m_residualCacheMutex);
+        m_residualCache.clear();
+    }
+
+    qDebug() << "全局搜索 [" << (evolve ? "差分进化" : "拉丁超立方") << "]: 起点" << m_fitStats.globalStarts << "个, 淘汰"
+             << m_fitStats.globalPruned << "个, 曲线求值" << m_fitStats.globalCurves << "条, 解析灵敏度"
+             << m_fitStats.globalSensitivityPasses << "次, 缓存命中" << m_fitStats.cacheHits << "次, 耗时"
+             << timer.elapsed() << "ms";
+    for (int k = 0; k < m_globalCandidates.size(); ++k) {
+        const GlobalCandidate& c = m_globalCandidates[k];
+        QStringList values;
+        for (const QString& name : fittedNames) values.append(QString("%1=%2").arg(name).arg(c.params.value(name), 0, 'g', 6));
+        qDebug() << "全局候选" << k + 1 << ": 均方误差" << c.mse << ", 迭代" << c.iterations << "次"
+                 << (c.pruned ? "(淘汰)" : "") << (c.duplicate ? "(重复)" : "") << values.join(", ");
+    }
+    return !m_globalCandidates.isEmpty();
+}
+
+bool FittingCore::isLogScale(const FitParameter& param, double value) {
+    return value > 1e-12 && param.name != "S" && param.name != "nf";
+}
+
+double FittingCore::toUnit(const FitParameter& param, double value) {
+    if (!(param.max > param.min)) return 0.5;
+    // 整个上下限区间按对数映射要求下限本身满足对数判定
+    bool isLog = isLogScale(param, param.min);
+    double u;
+    if (isLog) {
+        if (!(value > 0.0)) return 0.0;
+        u = (log10(value) - log10(param.min)) / (log10(param.max) - log10(param.min));
+    } else {
+        u = (value - param.min) / (param.max - param.min);
+    }
+    return qBound(0.0, u, 1.0);
+}
+
+double FittingCore::fromUnit(const FitParameter& param, double u) {
+    if (!(param.max > param.min)) return param.value;
+    bool isLog = isLogScale(param, param.min);
+    if (isLog) return pow(10.0, log10(param.min) + u * (log10(param.max) - log10(param.min)));
+    return param.min + u * (param.max - param.min);
+}
+
+QVector<QVector<double>> FittingCore::latinHypercube(int dims, int count, std::mt19937& rng) {
+    QVector<QVector<double>> samples(count, QVector<double>(dims));
+    if (count <= 0) return samples;
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    QVector<int> strata(count);
+    for (int j = 0; j < dims; ++j) {
+        std::iota(strata.begin(), strata.end(), 0);
+        std::shuffle(strata.begin(), strata.end(), rng);
+        for (int k = 0; k < count; ++k) samples[k][j] = (strata[k] + unit(rng)) / count;
+    }
+    return samples;
+}
+
+QVector<double> FittingCore::cachedResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight,
+                                             const QVector<double>& t, const QVector<double>& obsP, const QVector<double>& obsD,
+                                             FitStats& stats) {
+    // 键: 参数名与数值的原始字节 (QMap 按名称有序)；同一次全局搜索内模型、权重与抽样点不变
+    QByteArray key;
+    for (auto it = params.constBegin(); it != params.constEnd(); ++it) {
+        double value = it.value();
+        key += it.key().toUtf8();
+        key += '=';
+        key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    {
+        QMutexLocker locker(&m_residualCacheMutex);
+        auto it = m_residualCache.constFind(key);
+        if (it != m_residualCache.constEnd()) {
+            stats.cacheHits++;
+            return it.value();
+        }
+    }
+    QVector<double> residuals = calculateResiduals(params, modelType, weight, t, obsP, obsD);
+    stats.residualCurves++;
+    QMutexLocker locker(&m_residualCacheMutex);
+    m_residualCache.insert(key, residuals);
+    return residuals;
+}
+
+QMap<QString, double> FittingCore::applyFidelity(const QMap<QString, double>& params, int level, const QStringList& fittedNames) {
+    // 最高级不做任何覆盖 (即用户设置)；被拟合的参数本身不覆盖
+    QMap<QString, double> result = params;
+    if (level < 0 || level >= FidelityLevelCount) return result;
+    const FidelityLevel& rung = FidelityLadder[level];
+    auto overrideValue = [&](const QString& key, double value) {
+        if (!fittedNames.contains(key)) result[key] = value;
+    };
+    if (rung.stehfestN > 0) overrideValue("N", qMin((double)rung.stehfestN, params.value("N", 10.0)));
+    if (rung.segmentScale < 1.0) {
+        overrideValue("n_seg", qMax(2.0, std::round(params.value("n_seg", 5.0) * rung.segmentScale)));
+    }
+    if (rung.farFieldTol > 0.0) overrideValue("farFieldTol", qMax(rung.farFieldTol, params.value("farFieldTol", 1e-11)));
+    if (rung.asymptoticTol > 0.0) overrideValue("asymptoticTol", qMax(rung.asymptoticTol, params.value("asymptoticTol", 1e-10)));
+    // 解析灵敏度按稠密组装、不走分级积分与渐近捷径: 本级放宽了实际生效的容差时，
+    // 雅可比矩阵改用中心差分 (与本级残差曲线的求解方式一致)
+    bool looserFarField = params.value("farFieldTiers", 1.0) > 0.5 && rung.farFieldTol > params.value("farFieldTol", 1e-11);
+    bool looserAsymptotic = params.value("asymptotic", 1.0) > 0.5 && rung.asymptoticTol > params.value("asymptoticTol", 1e-10);
+    if (looserFarField || looserAsymptotic) result["analyticJacobian"] = 0.0;
+    return result;
+}
+
+void FittingCore::subsampleData(int maxCount, QVector<double>& t, QVector<double>& p, QVector<double>& d) {
+    // 抽样数据已按对数时间分布，按下标等间隔抽取即保持对数均匀，首末点保留
+    int n = t.size();
+    if (maxCount <= 1 || n <= maxCount) return;
+    QVector<double> outT, outP, outD;
+    for (int i = 0; i < maxCount; ++i) {
+        int idx = (int)std::lround((double)i * (n - 1) / (maxCount - 1));
+        outT.append(t[idx]);
+        outP.append(idx < p.size() ? p[idx] : 0.0);
+        outD.append(idx < d.size() ? d[idx] : 0.0);
+    }
+    t = outT; p = outP; d = outD;
+}
+
+bool FittingCore::stepParams(const QMap<QString, double>& current, const QList<FitParameter>& params,
+                             const QVector<int>& fitIndices, const QVector<double>& delta,
+                             QMap<QString, double>& trial, QVector<double>& appliedStep) {
+    int nParams = fitIndices.size();
+    trial = current;
+    appliedStep = QVector<double>(nParams, 0.0);
+    bool valid = true;
+    for(int i=0; i<nParams; ++i) {
+        int pIdx = fitIndices[i];
+        QString pName = params[pIdx].name;
+        double oldVal = current.value(pName);
+        bool isLog = isLogScale(params[pIdx], oldVal);
+        double newVal;
+        if(isLog) newVal = pow(10.0, log10(oldVal) + delta[i]);
+        else newVal = oldVal + delta[i];
+        newVal = qMax(params[pIdx].min, qMin(newVal, params[pIdx].max));
+        trial[pName] = newVal;
+        if (isLog) {
+            if (isLogScale(params[pIdx], newVal)) appliedStep[i] = log10(newVal) - log10(oldVal);
+            else valid = false;
+        } else {
+            appliedStep[i] = newVal - oldVal;
+        }
+    }
+    return valid;
+}
+
+void FittingCore::normalEquations(const QVector<QVector<double>>& J, const QVector<double>& residuals, int nParams,
+                                  QVector<QVector<double>>& H, QVector<double>& g) {
+    H = QVector<QVector<double>>(nParams, QVector<double>(nParams, 0.0));
+    g = QVector<double>(nParams, 0.0);
+    int nRes = qMin(J.size(), residuals.size());
+    for(int k=0; k<nRes; ++k) {
+        for(int i=0; i<nParams; ++i) {
+            g[i] += J[k][i] * residuals[k];
+            for(int j=0; j<=i; ++j) {
+                H[i][j] += J[k][i] * J[k][j];
+            }
+        }
+    }
+    for(int i=0; i<nParams; ++i) {
+        for(int j=i+1; j<nParams; ++j) H[i][j] = H[j][i];
+    }
+}
 
-    QMap<QString, double> finalSolverParams = preprocessParams(currentParamMap, modelType);
-    ModelCurveData finalCurve = m_modelManager->calculateTheoreticalCurve(modelType, finalSolverParams);
-    emit sigIterationUpdated(currentSSE/residuals.size(), currentParamMap, std::get<0>(finalCurve), std::get<1>(finalCurve), std::get<2>(finalCurve));
+bool FittingCore::broydenUpdate(QVector<QVector<double>>& J, const QVector<double>& step,
+                                const QVector<double>& oldResiduals, const QVector<double>& newResiduals) {
+    int nRes = J.size();
+    if (oldResiduals.size() != nRes || newResiduals.size() != nRes) return false;
+    double stepNorm2 = 0.0;
+    for (double s : step) stepNorm2 += s * s;
+    if (!(stepNorm2 > 1e-30) || !std::isfinite(stepNorm2)) return false;
+
+    for (int k = 0; k < nRes; ++k) {
+        double predicted = 0.0;
+        for (int i = 0; i < step.size(); ++i) predicted += J[k][i] * step[i];
+        double correction = (newResiduals[k] - oldResiduals[k] - predicted) / stepNorm2;
+        for (int i = 0; i < step.size(); ++i) J[k][i] += correction * step[i];
+    }
+    return true;
 }
 
 QVector<double> FittingCore::calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight,
-                                                const QVector<double>& t, const QVector<double>& obsP, const QVector<double>& obsD) {
+                                                const QVector<double>& t, const QVector<double>& obsP, const QVector<double>& obsD,
+                                                ModelCurveData* curve) {
     if(!m_modelManager || t.isEmpty()) return QVector<double>();
 
     // [关键] 参数预处理
     QMap<QString, double> solverParams = preprocessParams(params, modelType);
 
     ModelCurveData res = m_modelManager->calculateTheoreticalCurve(modelType, solverParams, t);
+    if (curve) *curve = res;
     const QVector<double>& pCal = std::get<1>(res);
     const QVector<double>& dpCal = std::get<2>(res);
 
@@ -377,54 +986,138 @@ QVector<double> FittingCore::calculateResiduals(const QMap<QString, double>& par
 QVector<QVector<double>> FittingCore::computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals,
                                                       const QVector<int>& fitIndices, ModelManager::ModelType modelType,
                                                       const QList<FitParameter>& currentFitParams, double weight,
-                                                      const QVector<double>& t, const QVector<double>& obsP, const QVector<double>& obsD) {
+                                                      const QVector<double>& t, const QVector<double>& obsP, const QVector<double>& obsD,
+                                                      FitStats& stats) {
     int nRes = baseResiduals.size();
     int nParams = fitIndices.size();
     QVector<QVector<double>> J(nRes, QVector<double>(nParams));
 
-    QVector<int> indices(nParams);
-    std::iota(indices.begin(), indices.end(), 0);
-
-    auto computeColumn = [&](int j) -> QVector<double> {
-        int idx = fitIndices[j];
+    // 可解析求导的列由一次灵敏度计算给出，其余列 (nf 等整数参数、复变量反演) 退回中心差分
+    QVector<bool> analytic = computeAnalyticColumns(params, fitIndices, modelType, currentFitParams, weight, t, obsP, obsD, J, stats);
+    QVector<int> columns;
+    for (int j = 0; j < nParams; ++j) {
+        if (!analytic[j]) columns.append(j);
+    }
+    if (columns.isEmpty()) return J;
+
+    // 每个参数的 +h / -h 两条扰动曲线各为一个任务 (共 2*差分列数 个)，由工作窃取调度器执行；
+    // 每条曲线内部的 (时间点 × Stehfest 项) 任务嵌套提交到同一调度器，空闲线程直接窃取，不再互相阻塞
+    int nColumns = columns.size();
+    QVector<double> steps(nColumns);
+    QVector<QMap<QString, double>> perturbed(2 * nColumns);
+    for (int c = 0; c < nColumns; ++c) {
+        int idx = fitIndices[columns[c]];
         QString pName = currentFitParams[idx].name;
         double val = params.value(pName);
-        bool isLog = (val > 1e-12 && pName != "S" && pName != "nf");
+        bool isLog = isLogScale(currentFitParams[idx], val);
 
-        double h;
+        // 差分列要求曲线为直接反演结果: 开启曲线缓存时也不允许读取插值曲线
         QMap<QString, double> pPlus = params;
-        QMap<QString, double> pMinus = params;
-
+        pPlus["curveCacheInterp"] = 0.0;
+        QMap<QString, double> pMinus = pPlus;
         if(isLog) {
-            h = 0.01;
+            steps[c] = 0.01;
             double valLog = log10(val);
-            pPlus[pName] = pow(10.0, valLog + h);
-            pMinus[pName] = pow(10.0, valLog - h);
+            pPlus[pName] = pow(10.0, valLog + steps[c]);
+            pMinus[pName] = pow(10.0, valLog - steps[c]);
+        } else {
+            steps[c] = 1e-4;
+            pPlus[pName] = val + steps[c];
+            pMinus[pName] = val - steps[c];
+        }
+        perturbed[2 * c] = pPlus;
+        perturbed[2 * c + 1] = pMinus;
+    }
+
+    // calculateResiduals 内部会自动调用 preprocessParams，直接传递扰动参数即可
+    stats.jacobianCurves += 2 * nColumns;
+    QVector<QVector<double>> residuals(2 * nColumns);
+    TaskScheduler::instance().parallelFor(2 * nColumns, [&](int k) {
+        residuals[k] = this->calculateResiduals(perturbed[k], modelType, weight, t, obsP, obsD);
+    });
+
+    for(int c=0; c<nColumns; ++c) {
+        const QVector<double>& rPlus = residuals[2 * c];
+        const QVector<double>& rMinus = residuals[2 * c + 1];
+        if(rPlus.size() != nRes || rMinus.size() != nRes) continue;
+        int j = columns[c];
+        for(int i=0; i<nRes; ++i) J[i][j] = (rPlus[i] - rMinus[i]) / (2.0 * steps[c]);
+    }
+    return J;
+}
+
+QVector<bool> FittingCore::computeAnalyticColumns(const QMap<QString, double>& params, const QVector<int>& fitIndices,
+                                                  ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams,
+                                                  double weight, const QVector<double>& t, const QVector<double>& obsP,
+                                                  const QVector<double>& obsD, QVector<QVector<double>>& J, FitStats& stats) {
+    int nParams = fitIndices.size();
+    int nRes = J.size();
+    QVector<bool> done(nParams, false);
+    QMap<QString, double> solverParams = preprocessParams(params, modelType);
+    if (!m_modelManager || solverParams.value("analyticJacobian", 1.0) < 0.5) return done;
+
+    // 1. 拟合变量 -> 求解器参数的链式系数。拟合变量与参数更新一致 (对数参数为 log10 值)，
+    //    preprocessParams 为闭式换算 (C -> cD、km -> M12 等)，直接小步长差分即可，不涉及曲线计算
+    const double h = 1e-6;
+    QVector<QMap<QString, double>> chains(nParams);
+    QStringList names;
+    for (int j = 0; j < nParams; ++j) {
+        QString pName = currentFitParams[fitIndices[j]].name;
+        double val = params.value(pName);
+        bool isLog = isLogScale(currentFitParams[fitIndices[j]], val);
+        QMap<QString, double> pPlus = params;
+        QMap<QString, double> pMinus = params;
+        if (isLog) {
+            pPlus[pName] = pow(10.0, log10(val) + h);
+            pMinus[pName] = pow(10.0, log10(val) - h);
         } else {
-            h = 1e-4;
             pPlus[pName] = val + h;
             pMinus[pName] = val - h;
         }
+        QMap<QString, double> sPlus = preprocessParams(pPlus, modelType);
+        QMap<QString, double> sMinus = preprocessParams(pMinus, modelType);
+        for (auto it = sPlus.constBegin(); it != sPlus.constEnd(); ++it) {
+            double d = (it.value() - sMinus.value(it.key())) / (2.0 * h);
+            if (d == 0.0) continue;
+            chains[j].insert(it.key(), d);
+            if (!names.contains(it.key())) names.append(it.key());
+        }
+    }
 
-        // calculateResiduals 内部会自动调用 preprocessParams，直接传递扰动参数即可
-        QVector<double> rPlus = this->calculateResiduals(pPlus, modelType, weight, t, obsP, obsD);
-        QVector<double> rMinus = this->calculateResiduals(pMinus, modelType, weight, t, obsP, obsD);
+    // 2. 一次求值得到理论曲线及其对全部相关求解器参数的灵敏度
+    CurveSensitivity::Result sens;
+    if (names.isEmpty() || !m_modelManager->calculateCurveSensitivity(modelType, solverParams, t, names, sens)) return done;
+    stats.sensitivityPasses++;
 
-        QVector<double> col(nRes, 0.0);
-        if(rPlus.size() == nRes && rMinus.size() == nRes) {
-            for(int i=0; i<nRes; ++i) col[i] = (rPlus[i] - rMinus[i]) / (2.0 * h);
+    // 3. 残差列: r = w·(ln obs - ln cal)，∂r = -w·∂cal/cal，行的排列与跳过条件与 calculateResiduals 相同
+    const QVector<double>& pCal = sens.pressure;
+    const QVector<double>& dpCal = sens.derivative;
+    int count = qMin((int)obsP.size(), (int)pCal.size());
+    int dCount = qMin(qMin((int)obsD.size(), (int)dpCal.size()), count);
+    if (count + dCount != nRes) return done;
+    double wp = weight;
+    double wd = 1.0 - weight;
+
+    for (int j = 0; j < nParams; ++j) {
+        bool supported = true;
+        for (auto it = chains[j].constBegin(); it != chains[j].constEnd(); ++it) {
+            supported = supported && sens.dPressure.contains(it.key());
         }
-        return col;
-    };
+        if (!supported) continue;
 
-    QList<QVector<double>> results = QtConcurrent::blockingMapped(indices, computeColumn);
-    for(int j=0; j<nParams; ++j) {
-        const QVector<double>& col = results[j];
-        for(int i=0; i<nRes; ++i) {
-            if (i < col.size()) J[i][j] = col[i];
+        for (int i = 0; i < count; ++i) {
+            double dp = 0.0;
+            for (auto it = chains[j].constBegin(); it != chains[j].constEnd(); ++it) dp += it.value() * sens.dPressure[it.key()][i];
+            J[i][j] = (obsP[i] > 1e-10 && pCal[i] > 1e-10) ? -wp * dp / pCal[i] : 0.0;
         }
+        for (int i = 0; i < dCount; ++i) {
+            double dd = 0.0;
+            for (auto it = chains[j].constBegin(); it != chains[j].constEnd(); ++it) dd += it.value() * sens.dDerivative[it.key()][i];
+            J[count + i][j] = (obsD[i] > 1e-10 && dpCal[i] > 1e-10) ? -wd * dd / dpCal[i] : 0.0;
+        }
+        done[j] = true;
     }
-    return J;
+    return done;
 }
 
 QVector<double> FittingCore::solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b) {
@@ -7,6 +7,15 @@
  * 3. 管理拟合过程中的数学计算（残差、雅可比矩阵、线性方程组求解）。
  * 4. 提供异步拟合控制接口。
  * 5. [新增] 提供参数预处理函数 preprocessParams，确保拟合计算与模型界面算法一致。
+ * 6. 雅可比矩阵的扰动曲线以任务形式提交到全局工作窃取调度器，与曲线内部的求值任务统一调度。
+ * 7. 雅可比矩阵优先由模型解析灵敏度一次求出 (ModelManager::calculateCurveSensitivity)，不适用的列退回中心差分。
+ * 8. 可选 Broyden 秩一更新代替每次迭代的完整雅可比计算 (默认开启)，统计每次拟合的曲线求值次数。
+ * 9. 迭代显示曲线复用残差计算的理论曲线 (抽样时间点)，不再为显示单独求解。
+ * 10. 多保真度拟合: 求解器精度 (Stehfest 阶数、离散段数、积分容差) 与抽样点数按阶梯逐级提高，
+ *     以参数字典覆盖的方式传给求解器，两组求解器一致生效。
+ * 11. 全局搜索: 在拟合参数上下限内按拉丁超立方 (可选差分进化) 撒多个起点，并行做局部 LM，
+ *     淘汰明显落后的起点并共享残差缓存，候选解按误差排序，最优解再按正常流程精修。
+ * 12. 放宽了远场/渐近容差的保真度级别关闭解析雅可比 (analyticJacobian=0)，改用与残差一致的中心差分。
  */
 
 #ifndef FITTINGCORE_H
@@ -16,6 +25,11 @@
 #include <QVector>
 #include <QMap>
 #include <QFutureWatcher>
+#include <QHash>
+#include <QByteArray>
+#include <QMutex>
+#include <random>
+#include <atomic>
 #include "modelmanager.h"
 #include "fittingsamplingdialog.h"
 #include "fittingparameterchart.h"
@@ -41,14 +55,74 @@ public:
     // 停止拟合
     void stopFit();
 
+    // 雅可比矩阵更新策略: broyden 为 true 时接受的步只做秩一更新，
+    // 步被拒绝、进展停滞或距上次完整计算满 refreshInterval 次迭代时重新完整计算
+    void setJacobianUpdate(bool broyden, int refreshInterval = 5);
+
+    // 是否使用保真度阶梯 (关闭时全程使用用户设置)
+    void setFidelityLadder(bool enabled);
+
+    // 全局搜索的探索方式
+    enum GlobalExploration {
+        LatinHypercube = 0,         // 拉丁超立方样本直接作为局部拟合起点
+        DifferentialEvolution       // 以拉丁超立方样本为初始种群进化若干代，取最优的个体作为起点
+    };
+    // 全局搜索: 在各拟合参数上下限内取 starts 个起点 (含当前参数) 并行做局部 LM，
+    // 最优候选再作为初值按正常流程拟合；starts < 2 时等同于关闭
+    void setGlobalSearch(bool enabled, int starts = 8, GlobalExploration exploration = LatinHypercube);
+
+    // 全局搜索的一个候选解
+    struct GlobalCandidate
+    {
+        QMap<QString, double> params;
+        double mse = 0.0;           // 全局搜索保真度下的每点均方误差
+        int iterations = 0;         // 局部 LM 迭代次数
+        bool pruned = false;        // 因明显落后被提前淘汰
+        bool duplicate = false;     // 与更优的候选收敛到同一位置
+    };
+    // 最近一次全局搜索的候选解 (按均方误差升序，未做全局搜索时为空)
+    QVector<GlobalCandidate> lastGlobalCandidates() const;
+
+    // 一次拟合的求值统计 (每次拟合开始时清零)
+    struct FitStats
+    {
+        int iterations = 0;         // 外层迭代次数
+        int residualCurves = 0;     // 残差曲线 (初值与试探步)
+        int jacobianCurves = 0;     // 差分雅可比的扰动曲线
+        int sensitivityPasses = 0;  // 解析灵敏度求值
+        int displayCurves = 0;      // 界面显示曲线
+        int fullJacobians = 0;      // 完整雅可比计算次数
+        int broydenUpdates = 0;     // 秩一更新次数
+        int globalStarts = 0;       // 全局搜索起点数
+        int globalPruned = 0;       // 被淘汰的起点数
+        int globalCurves = 0;       // 全局搜索阶段的残差与差分雅可比曲线
+        int globalSensitivityPasses = 0; // 全局搜索阶段的解析灵敏度求值
+        int cacheHits = 0;          // 残差缓存命中次数
+
+        // 保真度阶梯各级的统计 (按进入顺序)
+        struct Level
+        {
+            QString name;
+            int samples = 0;            // 抽样点数
+            double error = 0.0;         // 本级误差 (与最高级残差之差的均方根，本级各次测量的最大值)
+            int iterations = 0;
+            qint64 milliseconds = 0;
+        };
+        QVector<Level> levels;
+    };
+    // 最近一次拟合的求值统计
+    FitStats lastFitStats() const;
+
     // 辅助函数：根据当前策略获取抽样数据（可供界面绘图使用）
     void getLogSampledData(const QVector<double>& srcT, const QVector<double>& srcP, const QVector<double>& srcD,
                            QVector<double>& outT, QVector<double>& outP, QVector<double>& outD);
 
     // 计算残差 (公开以便计算最终误差)
     // [修改] 内部会自动调用 preprocessParams 进行参数转换
+    // curve 非空时同时返回计算残差所用的理论曲线 (供显示复用)
     QVector<double> calculateResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight,
-                                       const QVector<double>& t, const QVector<double>& obsP, const QVector<double>& obsD);
+                                       const QVector<double>& t, const QVector<double>& obsP, const QVector<double>& obsD,
+                                       ModelCurveData* curve = nullptr);
 
     // 计算误差平方和
     double calculateSumSquaredError(const QVector<double>& residuals);
@@ -74,12 +148,59 @@ private:
     bool m_isCustomSamplingEnabled;
     QList<SamplingInterval> m_customIntervals;
 
-    bool m_stopRequested;
+    std::atomic<bool> m_stopRequested;     // 界面线程置位，拟合线程与全局搜索的并行任务读取
     QFutureWatcher<void> m_watcher;
 
+    bool m_broydenUpdates;      // 是否使用 Broyden 秩一更新
+    int m_jacobianRefresh;      // 两次完整雅可比计算之间的最多迭代次数
+    bool m_fidelityLadder;      // 是否使用保真度阶梯
+    bool m_globalSearch;        // 是否先做全局搜索
+    int m_globalStarts;         // 全局搜索起点数
+    GlobalExploration m_globalExploration;
+    FitStats m_fitStats;
+    QVector<GlobalCandidate> m_globalCandidates;
+
+    // 全局搜索期间各起点共享的残差缓存 (键为覆盖保真度后的完整参数字典)
+    QMutex m_residualCacheMutex;
+    QHash<QByteArray, QVector<double>> m_residualCache;
+
+    // 保真度阶梯的一级: 数值为 0 的项不覆盖用户设置
+    struct FidelityLevel
+    {
+        const char* name;
+        int stehfestN;          // Stehfest 阶数上限
+        double segmentScale;    // 裂缝离散段数比例
+        double farFieldTol;     // 远场分级积分容差下限
+        double asymptoticTol;   // 渐近捷径容差下限
+        int maxSamples;         // 拟合抽样点数上限
+    };
+    static const int FidelityLevelCount = 3;
+    static const FidelityLevel FidelityLadder[FidelityLevelCount];
+
+    // 按保真度级别覆盖求解器参数 (被拟合的参数不覆盖)；放宽远场/渐近容差的级别同时关闭解析雅可比
+    static QMap<QString, double> applyFidelity(const QMap<QString, double>& params, int level, const QStringList& fittedNames);
+    // 按下标等间隔抽取至多 maxCount 个点
+    static void subsampleData(int maxCount, QVector<double>& t, QVector<double>& p, QVector<double>& d);
+
+    // 参数在 value 处是否按对数尺度处理 (LM 步长、差分步长与单位超立方体映射共用同一判定)
+    static bool isLogScale(const FitParameter& param, double value);
+    // 拟合参数在单位超立方体中的坐标 (下限满足对数判定时按 log10 均匀)，上下限无效时取中点/当前值
+    static double toUnit(const FitParameter& param, double value);
+    static double fromUnit(const FitParameter& param, double u);
+    // 单位超立方体内 count 个拉丁超立方样本 (每一维的 count 个等分区间各取一个点)
+    static QVector<QVector<double>> latinHypercube(int dims, int count, std::mt19937& rng);
+
+    // 带缓存的残差计算 (全局搜索期间使用，并行安全)
+    QVector<double> cachedResiduals(const QMap<QString, double>& params, ModelManager::ModelType modelType, double weight,
+                                    const QVector<double>& t, const QVector<double>& obsP, const QVector<double>& obsD,
+                                    FitStats& stats);
+
     // 内部运行的优化任务
     void runOptimizationTask(ModelManager::ModelType modelType, QList<FitParameter> fitParams, double weight);
 
+    // 多起点全局搜索，候选解写入 m_globalCandidates，无可用候选时返回 false
+    bool runGlobalSearch(ModelManager::ModelType modelType, const QList<FitParameter>& params, double weight);
+
     // LM算法实现
     void runLevenbergMarquardtOptimization(ModelManager::ModelType modelType, QList<FitParameter> params, double weight);
 
@@ -87,7 +208,28 @@ private:
     QVector<QVector<double>> computeJacobian(const QMap<QString, double>& params, const QVector<double>& baseResiduals,
                                              const QVector<int>& fitIndices, ModelManager::ModelType modelType,
                                              const QList<FitParameter>& currentFitParams, double weight,
-                                             const QVector<double>& t, const QVector<double>& obsP, const QVector<double>& obsD);
+                                             const QVector<double>& t, const QVector<double>& obsP, const QVector<double>& obsD,
+                                             FitStats& stats);
+
+    // 由解析灵敏度填充雅可比矩阵的列，返回各列是否已填充 (未填充的列由调用方差分)。
+    // 灵敏度只支持 Stehfest 反演与稠密边界元 (curvesensitivity.h)；复变量反演、Bourdet 导数、H 矩阵模式下全部列退回差分
+    QVector<bool> computeAnalyticColumns(const QMap<QString, double>& params, const QVector<int>& fitIndices,
+                                         ModelManager::ModelType modelType, const QList<FitParameter>& currentFitParams,
+                                         double weight, const QVector<double>& t, const QVector<double>& obsP,
+                                         const QVector<double>& obsD, QVector<QVector<double>>& J, FitStats& stats);
+
+    // 按拟合变量空间的步长 delta 生成试探参数 (对数参数为 log10 值，截断到上下限)，
+    // appliedStep 为截断后实际走过的步长；对数参数被截断到非正值时返回 false
+    static bool stepParams(const QMap<QString, double>& current, const QList<FitParameter>& params,
+                           const QVector<int>& fitIndices, const QVector<double>& delta,
+                           QMap<QString, double>& trial, QVector<double>& appliedStep);
+    // 正规方程 H = JᵀJ、g = Jᵀr
+    static void normalEquations(const QVector<QVector<double>>& J, const QVector<double>& residuals, int nParams,
+                                QVector<QVector<double>>& H, QVector<double>& g);
+
+    // Broyden 秩一更新: 使 J 满足割线条件 J·step = newResiduals - oldResiduals，步长为零时返回 false
+    static bool broydenUpdate(QVector<QVector<double>>& J, const QVector<double>& step,
+                              const QVector<double>& oldResiduals, const QVector<double>& newResiduals);
 
     // 求解线性方程组
     QVector<double> solveLinearSystem(const QVector<QVector<double>>& A, const QVector<double>& b);
@@ -9,6 +9,7 @@
  * - 根据 m_selections 中的配置，按需绘制实测压差、实测导数、理论压差、理论导数。
  * - 修复 rescaleAxes 逻辑，确保包含实测数据的显示范围。
  * 4. 绘制多条曲线，使用颜色区分不同分析。
+ * 5. 各分析的理论曲线先统一收集，经 ModelManager 批量接口并行计算后再逐个绘制。
  */
 
 #include "fittingmultiples.h"
@@ -158,12 +159,54 @@ void FittingMultiplesWidget::initialize(const QMap<QString, QJsonObject> &states
     updateWindowsData();
 }
 
+ModelManager::CurveRequest FittingMultiplesWidget::buildCurveRequest(const QJsonObject& state)
+{
+    // 解析模型参数
+    ModelManager::CurveRequest request;
+    request.type = (ModelManager::ModelType)state["modelType"].toInt();
+    QMap<QString, double>& paramMap = request.params;
+    QJsonArray pArr = state["parameters"].toArray();
+    for(auto v : pArr) {
+        QJsonObject pObj = v.toObject();
+        paramMap.insert(pObj["name"].toString(), pObj["value"].toDouble());
+    }
+    if(paramMap.contains("L") && paramMap.contains("Lf") && paramMap["L"] > 1e-9)
+        paramMap["LfD"] = paramMap["Lf"] / paramMap["L"];
+    else
+        paramMap["LfD"] = 0.0;
+
+    // 确定计算时间序列 (优先用实测时间，否则生成默认)
+    QVector<double>& tCalc = request.time;
+    QJsonArray tArr = state["observedData"].toObject()["time"].toArray();
+    for(auto v : tArr) tCalc.append(v.toDouble());
+    if (tCalc.isEmpty()) {
+        for(double e = -4; e <= 4; e += 0.1) tCalc.append(pow(10, e));
+    }
+
+    // 实测时间点较多时启用 Laplace 解插值模式: 先在对数 z 网格上自适应建表，
+    // 计算量取决于曲线复杂程度而非实测点数
+    if (tCalc.size() > 100) paramMap["laplaceInterp"] = 1.0;
+    return request;
+}
+
 void FittingMultiplesWidget::updateCharts()
 {
     if(!m_modelManager || !m_plot) return;
 
     m_plot->clearGraphs();
 
+    // 先收集全部需要理论曲线的分析，一次批量提交并行计算，再逐个绘制
+    QVector<ModelManager::CurveRequest> requests;
+    QMap<QString, int> requestIndex;
+    for(auto it = m_states.begin(); it != m_states.end(); ++it) {
+        CurveSelection sel;
+        if (m_selections.contains(it.key())) sel = m_selections[it.key()];
+        if (!sel.showTheoP && !sel.showTheoD) continue;
+        requestIndex.insert(it.key(), requests.size());
+        requests.append(buildCurveRequest(it.value()));
+    }
+    QVector<ModelCurveData> theoryCurves = m_modelManager->calculateTheoreticalCurves(requests);
+
     int idx = 0;
     for(auto it = m_states.begin(); it != m_states.end(); ++it) {
         QString name = it.key();
@@ -212,28 +255,8 @@ void FittingMultiplesWidget::updateCharts()
         // ==========================================
         // 2. 绘制理论曲线 (如果勾选)
         // ==========================================
-        if (sel.showTheoP || sel.showTheoD) {
-            // 解析模型参数
-            int typeInt = state["modelType"].toInt();
-            ModelManager::ModelType type = (ModelManager::ModelType)typeInt;
-            QMap<QString, double> paramMap;
-            QJsonArray pArr = state["parameters"].toArray();
-            for(auto v : pArr) {
-                QJsonObject pObj = v.toObject();
-                paramMap.insert(pObj["name"].toString(), pObj["value"].toDouble());
-            }
-            if(paramMap.contains("L") && paramMap.contains("Lf") && paramMap["L"] > 1e-9)
-                paramMap["LfD"] = paramMap["Lf"] / paramMap["L"];
-            else
-                paramMap["LfD"] = 0.0;
-
-            // 确定计算时间序列 (优先用实测时间，否则生成默认)
-            QVector<double> tCalc = obsT;
-            if (tCalc.isEmpty()) {
-                for(double e = -4; e <= 4; e += 0.1) tCalc.append(pow(10, e));
-            }
-
-            ModelCurveData curves = m_modelManager->calculateTheoreticalCurve(type, paramMap, tCalc);
+        if (requestIndex.contains(name)) {
+            const ModelCurveData& curves = theoryCurves[requestIndex[name]];
             QVector<double> vt = std::get<0>(curves);
             QVector<double> vp = std::get<1>(curves);
             QVector<double> vd = std::get<2>(curves);
@@ -83,6 +83,9 @@ private:
     // 刷新图表
     void updateCharts();
 
+    // 由保存的分析状态构建理论曲线计算请求 (模型、参数、时间点)
+    static ModelManager::CurveRequest buildCurveRequest(const QJsonObject& state);
+
     // 刷新浮动窗口内的表格数据
     void updateWindowsData();
 
@@ -4,6 +4,9 @@
  * 修改记录:
  * 1. 提取 generateDefaultParams 和 adjustLimits 为静态方法，供弹窗共用。
  * 2. 优化了参数生成逻辑结构。
+ * 3. 滚轮调参: 短间隔合并连续刻度后通知刷新；记录最近滚动的参数，
+ *    供界面预先计算该参数 ±1 个滚轮步长的曲线 (与滚轮实际产生的数值逐位一致)。
+ * 4. 不再跟踪鼠标悬停: 预先计算只由滚轮操作触发。
  */
 
 #include "fittingparameterchart.h"
@@ -26,7 +29,7 @@ FittingParameterChart::FittingParameterChart(QTableWidget *parentTable, QObject
     // 初始化滚轮防抖定时器
     m_wheelTimer = new QTimer(this);
     m_wheelTimer->setSingleShot(true);
-    m_wheelTimer->setInterval(200); // 200ms 延迟触发重绘
+    m_wheelTimer->setInterval(20); // 20ms 内的连续刻度合并为一次刷新 (刷新本身为后台预览 + 精算)
     connect(m_wheelTimer, &QTimer::timeout, this, &FittingParameterChart::onWheelDebounceTimeout);
 
     if(m_table) {
@@ -93,15 +96,10 @@ bool FittingParameterChart::eventFilter(QObject *watched, QEvent *event)
                 double currentVal = currentText.toDouble(&ok);
                 if (ok) {
                     int steps = wheelEvent->angleDelta().y() / 120; // 滚轮刻度
-                    double newVal = currentVal + steps * targetParam->step;
-
-                    // 范围限制
-                    if (targetParam->max > targetParam->min) {
-                        if (newVal < targetParam->min) newVal = targetParam->min;
-                        if (newVal > targetParam->max) newVal = targetParam->max;
-                    }
+                    double newVal = wheelStepValue(*targetParam, currentVal, steps);
                     item->setText(QString::number(newVal, 'g', 6));
                     targetParam->value = newVal;
+                    m_wheelParam = paramName;
                     m_wheelTimer->start(); // 重置定时器
                     return true; // 拦截事件，防止表格滚动
                 }
@@ -116,6 +114,45 @@ void FittingParameterChart::onWheelDebounceTimeout()
     emit parameterChangedByWheel();
 }
 
+double FittingParameterChart::wheelStepValue(const FitParameter& p, double current, int steps)
+{
+    double newVal = current + steps * p.step;
+
+    // 范围限制
+    if (p.max > p.min) {
+        if (newVal < p.min) newVal = p.min;
+        if (newVal > p.max) newVal = p.max;
+    }
+    return newVal;
+}
+
+bool FittingParameterChart::wheelNeighbours(QString& name, QString& lowerText, QString& upperText) const
+{
+    if (m_wheelParam.isEmpty() || !m_table) return false;
+
+    // 与 eventFilter 相同: 以单元格显示文本为当前值，按步长与上下限求下一刻度的数值，
+    // 并按单元格的显示格式给出文本 (界面取参数时读取的正是该文本)
+    for (int i = 0; i < m_table->rowCount(); ++i) {
+        QTableWidgetItem* k = m_table->item(i, 1);
+        QTableWidgetItem* v = m_table->item(i, 2);
+        if (!k || !v || k->data(Qt::UserRole).toString() != m_wheelParam) continue;
+
+        QString text = v->text();
+        if (text.contains(',') || text.contains(QChar(0xFF0C))) return false;
+        bool ok;
+        double currentVal = text.toDouble(&ok);
+        if (!ok) return false;
+        for (const auto& p : m_params) {
+            if (p.name != m_wheelParam) continue;
+            name = p.name;
+            lowerText = QString::number(wheelStepValue(p, currentVal, -1), 'g', 6);
+            upperText = QString::number(wheelStepValue(p, currentVal, 1), 'g', 6);
+            return true;
+        }
+    }
+    return false;
+}
+
 void FittingParameterChart::onTableItemChanged(QTableWidgetItem *item)
 {
     if (!item || item->column() != 2) return;
@@ -4,6 +4,7 @@
  * 修改记录:
  * 1. 新增 generateDefaultParams 静态方法，用于生成默认参数列表。
  * 2. 新增 adjustLimits 静态方法，用于计算参数上下限。
+ * 3. 新增最近滚动参数的相邻滚轮步长查询，供滚轮调参的预先计算使用。
  */
 
 #ifndef FITTINGPARAMETERCHART_H
@@ -73,6 +74,15 @@ public:
     // 获取表格中的原始文本（用于支持敏感性分析的逗号分隔输入）
     QMap<QString, QString> getRawParamTexts() const;
 
+    /**
+     * @brief 最近滚动的参数向下/向上再滚动一格后单元格将显示的文本
+     * @return 尚未滚动过参数、数值不可解析或为逗号分隔的敏感性输入时返回 false
+     */
+    bool wheelNeighbours(QString& name, QString& lowerText, QString& upperText) const;
+
+    // 参数滚动 steps 格后的数值 (按步长累加并限制在上下限内)
+    static double wheelStepValue(const FitParameter& p, double current, int steps);
+
 signals:
     // 当通过滚轮修改参数时触发，用于实时刷新图表
     void parameterChangedByWheel();
@@ -86,6 +96,7 @@ private:
     ModelManager* m_modelManager;   // 模型管理器
     QList<FitParameter> m_params;   // 内部参数数据
     QTimer* m_wheelTimer;           // 滚轮防抖定时器
+    QString m_wheelParam;           // 最近滚动的参数名
 
     // 刷新表格显示
     void refreshParamTable();
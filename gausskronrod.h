@@ -0,0 +1,146 @@
+/*
+ * 文件名: gausskronrod.h
+ * 文件作用: 自适应 Gauss-Kronrod 数值积分器 (仅头文件)
+ * 功能描述:
+ * 1. 实现 G7/K15 嵌套积分规则: 15 个 Kronrod 节点中包含 7 个 Gauss 节点，
+ *    一次面板计算同时得到积分值与误差估计，节点函数值全部复用。
+ * 2. 自适应二分使用显式栈代替递归，容差随层数减半，超过最大层数时直接接受当前面板。
+ * 3. 以模板参数接收被积函数，编译期内联，避免 std::function 类型擦除开销。
+ * 4. 同时支持标量被积函数 f(x) 与面板批量被积函数 f(const double* x, double* y, int n)，
+ *    后者一次调用计算一个面板全部 15 个节点 (配合 SpecialFunctions 批量贝塞尔函数)。
+ * 5. 可选统计被积函数调用次数与面板数。
+ * 6. 被积函数值类型可为 double 或 std::complex<double> (复 Laplace 变量下的边界元积分)。
+ */
+
+#ifndef GAUSSKRONROD_H
+#define GAUSSKRONROD_H
+
+#include <cmath>
+#include <complex>
+
+// 积分统计信息 (可跨多次积分累加)
+struct GaussKronrodStats
+{
+    long long evaluations = 0;  // 被积函数求值次数
+    long long panels = 0;       // 计算过的面板数
+};
+
+class GaussKronrod
+{
+public:
+    static const int PanelSize = 15;   // 每个面板的节点数
+    static const int MaxDepth = 40;    // 允许的最大二分层数
+
+    /**
+     * @brief 标量被积函数的自适应积分
+     * @param f 被积函数 double f(double)
+     * @param eps 相对容差: |K15 - G7| < eps * (|K15| + 1) 时接受面板，子区间容差减半
+     * @param maxDepth 最大二分层数: 第 maxDepth 层的面板 (长度 (b-a)/2^maxDepth) 不再二分，直接接受
+     * @param stats 可选统计信息
+     */
+    template <typename F>
+    static auto integrate(F&& f, double a, double b, double eps, int maxDepth,
+                          GaussKronrodStats* stats = nullptr) -> decltype(f(0.0))
+    {
+        using T = decltype(f(0.0));
+        auto panel = [&f](const double* x, T* y, int n) {
+            for (int i = 0; i < n; ++i) y[i] = f(x[i]);
+        };
+        return integrateBatch<T>(panel, a, b, eps, maxDepth, stats);
+    }
+
+    /**
+     * @brief 面板批量被积函数的自适应积分
+     * @param f 批量被积函数 void f(const double* x, T* y, int n)，n 恒为 PanelSize
+     * @tparam T 被积函数值类型 (缺省 double)
+     */
+    template <typename T = double, typename F>
+    static T integrateBatch(F&& f, double a, double b, double eps, int maxDepth,
+                            GaussKronrodStats* stats = nullptr)
+    {
+        if (maxDepth > MaxDepth) maxDepth = MaxDepth;
+        if (maxDepth < 0) maxDepth = 0;
+
+        // 显式栈: 深度优先，每层最多压入一个待处理的右半区间
+        struct Interval { double a; double b; double eps; int depth; };
+        Interval stack[MaxDepth + 2];
+        int top = 0;
+        stack[top++] = { a, b, eps, 0 };
+
+        T total = T(0.0);
+        while (top > 0) {
+            Interval iv = stack[--top];
+
+            double err = 0.0;
+            T val = panel<T>(f, iv.a, iv.b, err);
+            if (stats) {
+                stats->evaluations += PanelSize;
+                stats->panels += 1;
+            }
+
+            // 满足容差或到达最大层数时接受该面板，否则二分
+            if (iv.depth >= maxDepth || err < iv.eps * (std::abs(val) + 1.0)) {
+                total += val;
+            } else {
+                double c = 0.5 * (iv.a + iv.b);
+                stack[top++] = { c, iv.b, 0.5 * iv.eps, iv.depth + 1 };
+                stack[top++] = { iv.a, c, 0.5 * iv.eps, iv.depth + 1 };
+            }
+        }
+        return total;
+    }
+
+private:
+    // 单个面板的 K15 积分值，err 返回 |K15 - G7|
+    template <typename T, typename F>
+    static T panel(F& f, double a, double b, double& err)
+    {
+        // Kronrod 节点 (正半轴，最后一个为 0)；奇数下标同时为 7 点 Gauss 节点
+        static const double XK[8] = {
+            0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+            0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+            0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+            0.207784955007898467600689403773245, 0.000000000000000000000000000000000
+        };
+        static const double WK[8] = {
+            0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+            0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+            0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+            0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+        };
+        // Gauss 权重，对应 XK[1], XK[3], XK[5], XK[7]
+        static const double WG[4] = {
+            0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+            0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+        };
+
+        double c = 0.5 * (a + b);
+        double h = 0.5 * (b - a);
+
+        // 1. 组装节点: [0..6] 左侧, [7] 中点, [8..14] 右侧
+        double x[PanelSize];
+        T y[PanelSize];
+        for (int i = 0; i < 7; ++i) {
+            x[i] = c - h * XK[i];
+            x[14 - i] = c + h * XK[i];
+        }
+        x[7] = c;
+
+        // 2. 一次调用计算全部节点函数值
+        f(x, y, PanelSize);
+
+        // 3. 同一组函数值同时累加 Kronrod 与 Gauss 积分
+        T resK = WK[7] * y[7];
+        T resG = WG[3] * y[7];
+        for (int i = 0; i < 7; ++i) {
+            T pair = y[i] + y[14 - i];
+            resK += WK[i] * pair;
+            if (i % 2 == 1) resG += WG[i / 2] * pair;
+        }
+
+        err = std::abs((resK - resG) * h);
+        return resK * h;
+    }
+};
+
+#endif // GAUSSKRONROD_H
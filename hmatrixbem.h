@@ -0,0 +1,422 @@
+/*
+ * 文件名: hmatrixbem.h
+ * 文件作用: 边界元影响系数矩阵的层次矩阵 (H 矩阵) 表示与迭代求解 (仅头文件)
+ * 功能描述:
+ * 1. 裂缝沿井筒等间距排列，按裂缝编号建立二叉聚类树 (叶子不超过 LeafSegments 个离散段)。
+ * 2. 分块: 两个聚类包围盒满足 min(直径) <= η·距离 时为远场块，用自适应交叉近似 (ACA，部分主元)
+ *    压缩为低秩 U·Vᵀ，只计算 O(r·(m+n)) 个元素；其余叶子块按稠密存储。
+ *    矩阵对称，只保存上三角块，乘法时用转置补全下三角。
+ * 3. 求解 G·y = 1 使用重启 GMRES，预条件为对角叶子块的块 Jacobi (各块 LU 分解)，
+ *    存储与每步乘法开销近似为 O(n log n)，n = nf·n_seg。
+ * 4. 以模板实现，实数 (Stehfest) 与复对称 (Talbot / de Hoog) 共用；未收敛时由调用方退回稠密求解。
+ */
+
+#ifndef HMATRIXBEM_H
+#define HMATRIXBEM_H
+
+#include <Eigen/Dense>
+#include <QVector>
+#include <cmath>
+#include <complex>
+#include <algorithm>
+
+template <typename Scalar>
+class HMatrixBem
+{
+public:
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
+
+    static const int LeafSegments = 32;   // 叶子聚类的最大离散段数 (单条裂缝可超过)
+
+    // 最近一次组装/求解的统计
+    struct Stats {
+        int denseBlocks = 0;
+        int lowRankBlocks = 0;
+        long long storedEntries = 0;   // 压缩后存储的元素个数 (稠密为 n²/2 量级)
+        int maxRank = 0;
+        int iterations = 0;            // GMRES 迭代次数
+        bool converged = false;
+    };
+
+    HMatrixBem() : m_nf(-1), m_nSeg(-1), m_spacingD(0.0), m_LfD(0.0), m_n(0) {}
+
+    /**
+     * @brief 建立聚类树与分块结构 (只依赖几何，参数不变时直接返回)
+     * @param eta 容许性参数 η
+     */
+    void setupStructure(int nf, int nSeg, double spacingD, double LfD, double eta = 1.0)
+    {
+        if (nf == m_nf && nSeg == m_nSeg && spacingD == m_spacingD && LfD == m_LfD) return;
+        m_nf = nf;
+        m_nSeg = nSeg;
+        m_spacingD = spacingD;
+        m_LfD = LfD;
+        m_n = nf * nSeg;
+        m_blocks.clear();
+        m_clusters.clear();
+
+        // 1. 聚类树: 按裂缝编号区间二分
+        buildCluster(0, nf);
+
+        // 2. 分块: 只生成上三角 (含对角) 块
+        buildBlocks(0, 0, eta);
+    }
+
+    /**
+     * @brief 按当前分块结构计算全部块
+     * @param entry 元素函数 Scalar entry(int i, int j)，i、j 为全局离散段编号
+     * @param acaTol ACA 相对 Frobenius 容差
+     */
+    template <typename F>
+    void assemble(F&& entry, double acaTol)
+    {
+        m_stats = Stats();
+        double scale = std::abs(entry(0, 0));   // 零元判据的量级参考 (自感应系数)
+        for (int b = 0; b < m_blocks.size(); ++b) {
+            Block& blk = m_blocks[b];
+            if (blk.lowRank && aca(blk, entry, acaTol, scale)) {
+                m_stats.lowRankBlocks++;
+                m_stats.storedEntries += (long long)blk.U.size() + blk.V.size();
+                m_stats.maxRank = std::max(m_stats.maxRank, (int)blk.U.cols());
+            } else {
+                // 稠密块 (或 ACA 不划算时直接展开)
+                blk.U.resize(0, 0);
+                blk.V.resize(0, 0);
+                blk.D.resize(blk.rn, blk.cn);
+                for (int j = 0; j < blk.cn; ++j) {
+                    for (int i = 0; i < blk.rn; ++i) blk.D(i, j) = entry(blk.r0 + i, blk.c0 + j);
+                }
+                m_stats.denseBlocks++;
+                m_stats.storedEntries += blk.D.size();
+            }
+        }
+
+        // 块 Jacobi 预条件: 对角叶子块 LU 分解
+        m_precond.clear();
+        for (int b = 0; b < m_blocks.size(); ++b) {
+            const Block& blk = m_blocks[b];
+            if (blk.r0 == blk.c0 && blk.rn == blk.cn) {
+                DiagBlock db;
+                db.start = blk.r0;
+                db.lu.compute(blk.D);
+                m_precond.append(db);
+            }
+        }
+    }
+
+    /**
+     * @brief 重启 GMRES 求解 G·y = 1
+     * @param tol 预条件残差的相对容差
+     * @return 是否收敛
+     */
+    bool solveOnes(Vector& y, double tol = 1e-10, int maxIterations = 300, int restart = 40)
+    {
+        const int n = m_n;
+        Vector b = Vector::Ones(n);
+        Vector r(n), w(n), tmp(n);
+        y.setZero(n);
+
+        applyPrecond(b, r);
+        const double bnorm = r.norm();
+        if (!(bnorm > 0.0) || !std::isfinite(bnorm)) return false;
+
+        Matrix V(n, restart + 1);
+        Matrix H = Matrix::Zero(restart + 1, restart);
+        Vector g(restart + 1);
+        QVector<double> cs(restart);
+        QVector<Scalar> sn(restart);
+
+        int total = 0;
+        bool converged = false;
+        while (total < maxIterations && !converged) {
+            // 1. 残差 r = M⁻¹(b - G·y)
+            multiply(y, tmp);
+            tmp = b - tmp;
+            applyPrecond(tmp, r);
+            double beta = r.norm();
+            if (beta <= tol * bnorm) { converged = true; break; }
+
+            V.col(0) = r / beta;
+            g.setZero();
+            g(0) = beta;
+            H.setZero();
+
+            // 2. Arnoldi 过程 (修正 Gram-Schmidt) + Givens 旋转
+            int k = 0;
+            for (; k < restart && total < maxIterations; ++k, ++total) {
+                multiply(V.col(k), tmp);
+                applyPrecond(tmp, w);
+                for (int i = 0; i <= k; ++i) {
+                    H(i, k) = V.col(i).dot(w);
+                    w -= H(i, k) * V.col(i);
+                }
+                double hnext = w.norm();
+                H(k + 1, k) = hnext;
+                if (hnext > 0.0) V.col(k + 1) = w / hnext;
+
+                for (int i = 0; i < k; ++i) applyGivens(cs[i], sn[i], H(i, k), H(i + 1, k));
+                makeGivens(H(k, k), H(k + 1, k), cs[k], sn[k]);
+                applyGivens(cs[k], sn[k], H(k, k), H(k + 1, k));
+                H(k + 1, k) = Scalar(0.0);
+                applyGivens(cs[k], sn[k], g(k), g(k + 1));
+
+                if (std::abs(g(k + 1)) <= tol * bnorm || hnext == 0.0) {
+                    ++k;
+                    ++total;
+                    converged = true;
+                    break;
+                }
+            }
+
+            // 3. 回代求 Krylov 系数并更新解
+            if (k > 0) {
+                Vector coeff = H.topLeftCorner(k, k).template triangularView<Eigen::Upper>().solve(g.head(k));
+                y += V.leftCols(k) * coeff;
+            }
+            if (!std::isfinite(std::abs(y.sum()))) return false;
+        }
+
+        m_stats.iterations = total;
+        m_stats.converged = converged;
+        return converged;
+    }
+
+    // y = G·x (x、y 长度为 n)
+    template <typename VecIn>
+    void multiply(const VecIn& x, Vector& y) const
+    {
+        y.setZero(m_n);
+        for (int b = 0; b < m_blocks.size(); ++b) {
+            const Block& blk = m_blocks[b];
+            bool offDiag = (blk.r0 != blk.c0);
+            if (blk.D.size() == 0) {
+                // 低秩块: U·(Vᵀx)，对称部分 V·(Uᵀx)；秩 0 (数值为零的远场块) 直接跳过
+                if (blk.U.cols() == 0) continue;
+                y.segment(blk.r0, blk.rn).noalias() += blk.U * (blk.V.transpose() * x.segment(blk.c0, blk.cn));
+                if (offDiag) {
+                    y.segment(blk.c0, blk.cn).noalias() += blk.V * (blk.U.transpose() * x.segment(blk.r0, blk.rn));
+                }
+            } else {
+                y.segment(blk.r0, blk.rn).noalias() += blk.D * x.segment(blk.c0, blk.cn);
+                if (offDiag) {
+                    y.segment(blk.c0, blk.cn).noalias() += blk.D.transpose() * x.segment(blk.r0, blk.rn);
+                }
+            }
+        }
+    }
+
+    int size() const { return m_n; }
+    const Stats& stats() const { return m_stats; }
+
+private:
+    struct Cluster { int a; int b; int left; int right; };   // 裂缝编号区间 [a, b) 及子聚类 (叶子为 -1)
+    struct Block {
+        int r0, rn, c0, cn;   // 行/列离散段起点与长度
+        bool lowRank;         // 远场 (可压缩) 块
+        Matrix D;             // 稠密数据
+        Matrix U, V;          // 低秩数据 G ≈ U·Vᵀ
+    };
+    struct DiagBlock {
+        int start;
+        Eigen::PartialPivLU<Matrix> lu;
+    };
+
+    // 递归二分裂缝区间，返回聚类编号
+    int buildCluster(int a, int b)
+    {
+        int id = m_clusters.size();
+        m_clusters.append({a, b, -1, -1});
+        if (b - a > 1 && (b - a) * m_nSeg > LeafSegments) {
+            int mid = (a + b) / 2;
+            int left = buildCluster(a, mid);
+            int right = buildCluster(mid, b);
+            m_clusters[id].left = left;
+            m_clusters[id].right = right;
+        }
+        return id;
+    }
+
+    bool isLeaf(int c) const { return m_clusters[c].left < 0; }
+
+    // 聚类包围盒直径 (x 向为裂缝间距跨度，y 向为裂缝全长)
+    double diameter(int c) const
+    {
+        double dx = (m_clusters[c].b - m_clusters[c].a - 1) * m_spacingD;
+        double dy = 2.0 * m_LfD;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    // 两个不相交聚类 (c1 在 c2 之前) 的 x 向间隙
+    double distance(int c1, int c2) const
+    {
+        return (m_clusters[c2].a - (m_clusters[c1].b - 1)) * m_spacingD;
+    }
+
+    // 递归生成上三角块 (c1 == c2 或 c1 整体位于 c2 之前)
+    void buildBlocks(int c1, int c2, double eta)
+    {
+        if (c1 != c2) {
+            double dist = distance(c1, c2);
+            if (dist > 0.0 && std::min(diameter(c1), diameter(c2)) <= eta * dist) {
+                appendBlock(c1, c2, true);
+                return;
+            }
+        }
+        if (isLeaf(c1) && isLeaf(c2)) {
+            appendBlock(c1, c2, false);
+            return;
+        }
+        if (c1 == c2) {
+            int l = m_clusters[c1].left, r = m_clusters[c1].right;
+            buildBlocks(l, l, eta);
+            buildBlocks(l, r, eta);
+            buildBlocks(r, r, eta);
+            return;
+        }
+        // 拆分较大 (或唯一可拆) 的一侧
+        bool splitFirst = !isLeaf(c1) && (isLeaf(c2) ||
+                          (m_clusters[c1].b - m_clusters[c1].a) >= (m_clusters[c2].b - m_clusters[c2].a));
+        if (splitFirst) {
+            buildBlocks(m_clusters[c1].left, c2, eta);
+            buildBlocks(m_clusters[c1].right, c2, eta);
+        } else {
+            buildBlocks(c1, m_clusters[c2].left, eta);
+            buildBlocks(c1, m_clusters[c2].right, eta);
+        }
+    }
+
+    void appendBlock(int c1, int c2, bool lowRank)
+    {
+        Block blk;
+        blk.r0 = m_clusters[c1].a * m_nSeg;
+        blk.rn = (m_clusters[c1].b - m_clusters[c1].a) * m_nSeg;
+        blk.c0 = m_clusters[c2].a * m_nSeg;
+        blk.cn = (m_clusters[c2].b - m_clusters[c2].a) * m_nSeg;
+        blk.lowRank = lowRank;
+        m_blocks.append(blk);
+    }
+
+    /**
+     * @brief 部分主元 ACA: 交替取残差行、列构造秩一项，直至新项的 Frobenius 范数低于累计近似的 tol 倍
+     * @return false 表示秩过高 (存储不少于稠密块)，由调用方改为稠密块
+     */
+    template <typename F>
+    bool aca(Block& blk, F& entry, double tol, double scale)
+    {
+        const int m = blk.rn, n = blk.cn;
+        const int maxRank = (m * n) / (m + n);   // 超过此秩时低秩存储不再划算
+        const double zeroTol = 1e-14 * scale;
+        if (maxRank <= 0) return false;
+
+        QVector<Vector> us, vs;
+        QVector<char> rowUsed(m, 0);
+        double norm2 = 0.0;
+        // 行聚类整体位于列聚类之前，末行所在裂缝离列聚类最近，以其为首个主元行；
+        // 核函数随距离指数衰减 (z 较大时尤甚)，从远端行开始容易误判整块为零
+        int row = m - 1;
+        int zeroRows = 0;
+        Vector rv(n), cv(m);
+
+        while (us.size() < maxRank) {
+            rowUsed[row] = 1;
+
+            // 1. 残差行
+            for (int j = 0; j < n; ++j) rv(j) = entry(blk.r0 + row, blk.c0 + j);
+            for (int l = 0; l < us.size(); ++l) rv -= us[l](row) * vs[l];
+            int jp = 0;
+            double vmax = 0.0;
+            for (int j = 0; j < n; ++j) {
+                if (std::abs(rv(j)) > vmax) { vmax = std::abs(rv(j)); jp = j; }
+            }
+
+            if (vmax <= zeroTol) {
+                // 残差行为零: 由近及远再试其余行，连续 3 行为零视为块已被近似 (或整体可忽略)
+                if (++zeroRows >= 3) break;
+                int next = -1;
+                for (int i = m - 1; i >= 0; --i) if (!rowUsed[i]) { next = i; break; }
+                if (next < 0) break;
+                row = next;
+                continue;
+            }
+            zeroRows = 0;
+
+            // 2. 残差列
+            Vector v = rv / rv(jp);
+            for (int i = 0; i < m; ++i) cv(i) = entry(blk.r0 + i, blk.c0 + jp);
+            for (int l = 0; l < us.size(); ++l) cv -= vs[l](jp) * us[l];
+
+            // 3. 累计近似的 Frobenius 范数: ||S + u vᵀ||² = ||S||² + 2Re Σ(u_lᴴu)(v_lᴴv) + |u|²|v|²
+            double uv2 = cv.squaredNorm() * v.squaredNorm();
+            double cross = 0.0;
+            for (int l = 0; l < us.size(); ++l) cross += std::real(us[l].dot(cv) * vs[l].dot(v));
+            norm2 += 2.0 * cross + uv2;
+            us.append(cv);
+            vs.append(v);
+
+            if (uv2 <= tol * tol * norm2) break;
+
+            // 4. 下一主元行: 新列中绝对值最大的未用行
+            int next = -1;
+            double umax = -1.0;
+            for (int i = 0; i < m; ++i) {
+                if (!rowUsed[i] && std::abs(cv(i)) > umax) { umax = std::abs(cv(i)); next = i; }
+            }
+            if (next < 0) break;
+            row = next;
+        }
+
+        if (us.size() >= maxRank && maxRank > 0) return false;
+
+        int k = us.size();
+        blk.D.resize(0, 0);
+        blk.U.resize(m, k);
+        blk.V.resize(n, k);
+        for (int l = 0; l < k; ++l) {
+            blk.U.col(l) = us[l];
+            blk.V.col(l) = vs[l];
+        }
+        return true;
+    }
+
+    // 块 Jacobi 预条件 out = M⁻¹ in
+    void applyPrecond(const Vector& in, Vector& out) const
+    {
+        out.resize(in.size());
+        for (int b = 0; b < m_precond.size(); ++b) {
+            const DiagBlock& db = m_precond[b];
+            int len = (int)db.lu.rows();
+            out.segment(db.start, len) = db.lu.solve(in.segment(db.start, len));
+        }
+    }
+
+    // 复 Givens 旋转: [c s; -conj(s) c]·[a; b] = [ρ·a/|a|; 0]
+    static void makeGivens(const Scalar& a, const Scalar& b, double& c, Scalar& s)
+    {
+        double absA = std::abs(a), absB = std::abs(b);
+        if (absB == 0.0) { c = 1.0; s = Scalar(0.0); return; }
+        if (absA == 0.0) { c = 0.0; s = Scalar(1.0); return; }
+        double rho = std::sqrt(absA * absA + absB * absB);
+        c = absA / rho;
+        s = (a / absA) * Eigen::numext::conj(b) / rho;
+    }
+
+    static void applyGivens(double c, const Scalar& s, Scalar& x, Scalar& y)
+    {
+        Scalar t = c * x + s * y;
+        y = -Eigen::numext::conj(s) * x + c * y;
+        x = t;
+    }
+
+    int m_nf;
+    int m_nSeg;
+    double m_spacingD;
+    double m_LfD;
+    int m_n;
+    QVector<Cluster> m_clusters;
+    QVector<Block> m_blocks;
+    QVector<DiagBlock> m_precond;
+    Stats m_stats;
+};
+
+#endif // HMATRIXBEM_H
@@ -0,0 +1,137 @@
+/*
+ * 文件名: laplaceinterpolator.cpp
+ * 文件作用: Laplace 空间解的自适应对数网格插值表实现
+ * 功能描述:
+ * 1. 初始面板每十倍程一个，每个面板取 17 个 Chebyshev-Lobatto 节点，离散余弦变换得到系数。
+ * 2. 逐轮加密: 同一轮内所有待检验面板的节点一次性并行求值；末两项系数满足容差则接受，
+ *    否则二分进入下一轮；达到求值上限后剩余面板直接接受。
+ * 3. 查询时二分查找所在面板，Clenshaw 递推求值，g/z 即为 pf(z)。
+ */
+
+#include "laplaceinterpolator.h"
+#include "taskscheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+LaplaceInterpolator::LaplaceInterpolator() : m_evaluations(0) {}
+
+void LaplaceInterpolator::build(const std::function<double(double)>& func, double zMin, double zMax,
+                                double relTol, int maxEvaluations)
+{
+    const int n = PanelPoints;
+    m_panels.clear();
+    m_evaluations = 0;
+    if (!(zMin > 0.0) || !(zMax > zMin)) return;
+
+    // g(u) = z*pf(z)，u = ln z；非有限值按 0 处理 (与逐点计算时的保护一致)
+    auto evalG = [&func](double u) -> double {
+        double z = std::exp(u);
+        double pf = func(z);
+        if (std::isnan(pf) || std::isinf(pf)) pf = 0.0;
+        return z * pf;
+    };
+
+    // Lobatto 节点 x_j = cos(πj/(n-1))，j = 0..n-1 (从 +1 到 -1)
+    double nodes[PanelPoints];
+    for (int j = 0; j < n; ++j) nodes[j] = std::cos(M_PI * j / (n - 1));
+
+    // 1. 初始面板: 每十倍程一个
+    double uMin = std::log(zMin);
+    double uMax = std::log(zMax);
+    int nInit = std::max(1, (int)std::ceil((uMax - uMin) / std::log(10.0)));
+    QVector<Panel> pending;
+    for (int i = 0; i < nInit; ++i) {
+        Panel p;
+        p.uA = uMin + (uMax - uMin) * i / nInit;
+        p.uB = uMin + (uMax - uMin) * (i + 1) / nInit;
+        pending.append(p);
+    }
+
+    // 2. 逐轮检验与二分
+    while (!pending.isEmpty()) {
+        // 2.1 本轮全部节点一次性并行求值
+        QVector<double> us(pending.size() * n);
+        for (int p = 0; p < pending.size(); ++p) {
+            double c = 0.5 * (pending[p].uA + pending[p].uB);
+            double h = 0.5 * (pending[p].uB - pending[p].uA);
+            for (int j = 0; j < n; ++j) us[p * n + j] = c + h * nodes[j];
+        }
+        QVector<double> gs(us.size());
+        TaskScheduler::instance().parallelFor(us.size(), [&](int k) { gs[k] = evalG(us[k]); });
+        m_evaluations += us.size();
+
+        // 2.2 离散余弦变换求系数，并按末两项系数判断收敛
+        bool budgetLeft = (m_evaluations + 2 * pending.size() * n) <= maxEvaluations;
+        QVector<Panel> next;
+        for (int p = 0; p < pending.size(); ++p) {
+            Panel& panel = pending[p];
+            const double* g = &gs[p * n];
+            double scale = 0.0;
+            for (int j = 0; j < n; ++j) scale = std::max(scale, std::abs(g[j]));
+
+            for (int k = 0; k < n; ++k) {
+                double s = 0.5 * (g[0] + ((k % 2 == 0) ? g[n - 1] : -g[n - 1]));
+                for (int j = 1; j < n - 1; ++j) s += g[j] * std::cos(M_PI * j * k / (n - 1));
+                panel.c[k] = 2.0 * s / (n - 1);
+            }
+            panel.c[0] *= 0.5;
+            panel.c[n - 1] *= 0.5;
+
+            double tail = std::abs(panel.c[n - 1]) + std::abs(panel.c[n - 2]);
+            if (tail <= relTol * scale || !budgetLeft) {
+                m_panels.append(panel);
+            } else {
+                double mid = 0.5 * (panel.uA + panel.uB);
+                Panel left, right;
+                left.uA = panel.uA; left.uB = mid;
+                right.uA = mid; right.uB = panel.uB;
+                next.append(left);
+                next.append(right);
+            }
+        }
+        pending = next;
+    }
+
+    // 3. 面板按起点排序，便于二分查找
+    std::sort(m_panels.begin(), m_panels.end(),
+              [](const Panel& a, const Panel& b) { return a.uA < b.uA; });
+}
+
+double LaplaceInterpolator::value(double z) const
+{
+    if (!isValid() || z <= 0.0) return 0.0;
+    double u = std::log(z);
+
+    // 1. 二分查找所在面板 (区间外使用端点面板外推)
+    auto it = std::upper_bound(m_panels.begin(), m_panels.end(), u,
+                               [](double v, const Panel& p) { return v < p.uA; });
+    int idx = (int)(it - m_panels.begin()) - 1;
+    if (idx < 0) idx = 0;
+    const Panel& panel = m_panels[idx];
+
+    // 2. Clenshaw 递推: g(x) = Σ c_k T_k(x)
+    double x = (2.0 * u - panel.uA - panel.uB) / (panel.uB - panel.uA);
+    double b1 = 0.0, b2 = 0.0;
+    for (int k = PanelPoints - 1; k >= 1; --k) {
+        double tmp = 2.0 * x * b1 - b2 + panel.c[k];
+        b2 = b1;
+        b1 = tmp;
+    }
+    double g = x * b1 - b2 + panel.c[0];
+    return g / z;
+}
+
+int LaplaceInterpolator::evaluationCount() const
+{
+    return m_evaluations;
+}
+
+bool LaplaceInterpolator::isValid() const
+{
+    return !m_panels.isEmpty();
+}
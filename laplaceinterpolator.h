@@ -0,0 +1,56 @@
+/*
+ * 文件名: laplaceinterpolator.h
+ * 文件作用: Laplace 空间解的自适应对数网格插值表头文件
+ * 功能描述:
+ * 1. 在 u = ln z 上对 g(z) = z*pf(z) 建立分段 Chebyshev 插值表，pf 为 Laplace 空间井底压力解。
+ *    g 在 ln z 上光滑且量级稳定，分段 Chebyshev 插值按指数速度收敛。
+ * 2. 自适应加密: 初始每十倍程一个面板，每轮对全部待检验面板的 Chebyshev-Lobatto 节点并行求值，
+ *    末两项系数低于相对容差的面板接受，否则二分后进入下一轮，直至全部接受或达到求值上限。
+ * 3. 插值表建立后，任意 Stehfest 横坐标 z 的 pf(z) 均由插值得到，
+ *    求解器开销取决于曲线复杂程度而非请求的时间点数。
+ * 4. 供 ModelSolver01_06 与 ModelSolver19_36 的 calculatePDandDeriv 共用。
+ */
+
+#ifndef LAPLACEINTERPOLATOR_H
+#define LAPLACEINTERPOLATOR_H
+
+#include <QVector>
+#include <functional>
+
+class LaplaceInterpolator
+{
+public:
+    LaplaceInterpolator();
+
+    /**
+     * @brief 在 [zMin, zMax] 上自适应建立插值表
+     * @param func Laplace 空间解 pf(z) (可并行调用)
+     * @param relTol 面板末项 Chebyshev 系数相对面板最大值的容差
+     * @param maxEvaluations pf 求值次数上限 (防止病态函数无限加密)
+     */
+    void build(const std::function<double(double)>& func, double zMin, double zMax,
+               double relTol, int maxEvaluations = 4000);
+
+    // 插值得到 pf(z)；区间外按端点面板的多项式外推
+    double value(double z) const;
+
+    // 建表过程中 pf 的实际求值次数
+    int evaluationCount() const;
+
+    bool isValid() const;
+
+    static const int PanelPoints = 17;  // 每个面板的 Chebyshev-Lobatto 节点数
+
+private:
+    // 已接受的面板: [uA, uB] 上的 Chebyshev 系数
+    struct Panel {
+        double uA;
+        double uB;
+        double c[PanelPoints];
+    };
+
+    QVector<Panel> m_panels;  // 按 uA 升序排列
+    int m_evaluations;
+};
+
+#endif // LAPLACEINTERPOLATOR_H
@@ -0,0 +1,299 @@
+/*
+ * 文件名: laplaceinversion.cpp
+ * 文件作用: 复变量 Laplace 数值反演 (Talbot / de Hoog) 实现
+ * 功能描述:
+ * 1. Talbot: 时间窗 [t0, Λt0] 的抛物线围道参数取 h = 0.8 sqrt(1+8Λ)/N、μ = N/(Λ t0 sqrt(1+8Λ))
+ *    (按 Weideman-Trefethen 误差平衡的形式，系数由 ln t、erfc、e^-t 等已知解析反演对标定)。
+ *    Λ=5、N=28 时窗口内相对误差约 1e-9，每十倍程约 41 次求值；
+ *    实函数的 Laplace 解满足 F(conj s) = conj F(s)，只需计算上半围道。
+ * 2. de Hoog: T = 2 tmax，Bromwich 直线 Re s = -ln(tol)/(2T)，2M+1 项 Fourier 系数经 QD 算法
+ *    转为连分式，再用末项余项估计进一步加速。
+ *    阶数自适应: 比较 M 与 M-4 的结果 (同一组节点的前缀)，未收敛的窗口把 M 提高 4 并只补算新节点，
+ *    直到相对变化量小于给定容差、达到上限或明显发散 (高阶 QD 受舍入误差影响)；各窗口保留变化量最小的一次结果。
+ * 3. 各时间窗的求值点汇总后一次并行求值 (工作窃取调度器，可嵌套在外层并行任务中)。
+ * 4. 导数: 由 L[df/dt] = s·F(s) - f(0) 且 f(0)=0，把已求得的 F(s_k) 乘以 s_k 后按同一公式再求和一次，
+ *    结果乘以 t 即为 t·df/dt；de Hoog 对 s·F 的 Fourier 系数重新做一遍 QD 连分式。
+ */
+
+#include "laplaceinversion.h"
+#include "taskscheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+typedef std::complex<double> Complex;
+
+LaplaceInversion::LaplaceInversion() : m_evaluations(0) {}
+
+int LaplaceInversion::evaluationCount() const
+{
+    return m_evaluations;
+}
+
+LaplaceInversion::DeHoogStatus LaplaceInversion::deHoogStatus() const
+{
+    return m_deHoogStatus;
+}
+
+QVector<QVector<int>> LaplaceInversion::groupWindows(const QVector<double>& t, double windowRatio)
+{
+    // 1. 有效时间点按时间升序排列
+    QVector<int> order;
+    for (int i = 0; i < t.size(); ++i) {
+        if (t[i] > 1e-10) order.append(i);
+    }
+    std::sort(order.begin(), order.end(), [&t](int a, int b) { return t[a] < t[b]; });
+
+    // 2. 从最小时间开始，每个窗口覆盖 [t0, Λt0]
+    QVector<QVector<int>> windows;
+    double tEnd = 0.0;
+    for (int idx : order) {
+        if (windows.isEmpty() || t[idx] > tEnd) {
+            windows.append(QVector<int>());
+            tEnd = t[idx] * windowRatio;
+        }
+        windows.last().append(idx);
+    }
+    return windows;
+}
+
+QVector<std::complex<double>> LaplaceInversion::evaluateAll(const ComplexFunction& F,
+                                                             const QVector<std::complex<double>>& s)
+{
+    QVector<Complex> values(s.size());
+    TaskScheduler::instance().parallelFor(s.size(), [&](int k) {
+        Complex v = F(s[k]);
+        if (!std::isfinite(v.real()) || !std::isfinite(v.imag())) v = Complex(0.0, 0.0);
+        values[k] = v;
+    });
+    m_evaluations += s.size();
+    return values;
+}
+
+QVector<double> LaplaceInversion::talbot(const ComplexFunction& F, const QVector<double>& t,
+                                         int nodes, double windowRatio, QVector<double>* derivative)
+{
+    m_evaluations = 0;
+    QVector<double> result(t.size(), 0.0);
+    if (derivative) *derivative = QVector<double>(t.size(), 0.0);
+    if (nodes < 2) nodes = 2;
+    if (windowRatio < 1.0) windowRatio = 1.0;
+
+    QVector<QVector<int>> windows = groupWindows(t, windowRatio);
+    if (windows.isEmpty()) return result;
+
+    // 1. 每个窗口的围道参数与节点 s_k = μ(1+i u_k)^2，u_k = k h，k = 0..N
+    const int n = nodes + 1;
+    QVector<double> mu(windows.size()), step(windows.size());
+    QVector<Complex> s(windows.size() * n);
+    for (int w = 0; w < windows.size(); ++w) {
+        double t0 = t[windows[w].first()];
+        double lambda = 1.0;
+        for (int idx : windows[w]) lambda = std::max(lambda, t[idx] / t0);
+        double root = std::sqrt(1.0 + 8.0 * lambda);
+        step[w] = 0.8 * root / nodes;
+        mu[w] = nodes / (lambda * t0 * root);
+        for (int k = 0; k < n; ++k) {
+            Complex q(1.0, k * step[w]);
+            s[w * n + k] = mu[w] * q * q;
+        }
+    }
+
+    // 2. 全部节点一次性并行求值
+    QVector<Complex> values = evaluateAll(F, s);
+
+    // 3. 梯形求和: f(t) = (hμ/π) Re[ g(0) + 2 Σ g(u_k) ]，g(u) = e^{st} F(s) (1+iu)
+    //    导数把 F(s) 换成 s·F(s)
+    for (int w = 0; w < windows.size(); ++w) {
+        for (int idx : windows[w]) {
+            double tt = t[idx];
+            double sum = 0.0, sumDeriv = 0.0;
+            for (int k = 0; k < n; ++k) {
+                Complex sk = s[w * n + k];
+                Complex g = std::exp(sk * tt) * values[w * n + k] * Complex(1.0, k * step[w]);
+                double weight = (k == 0 ? 1.0 : 2.0);
+                sum += weight * g.real();
+                if (derivative) sumDeriv += weight * (sk * g).real();
+            }
+            result[idx] = step[w] * mu[w] / M_PI * sum;
+            if (derivative) (*derivative)[idx] = tt * step[w] * mu[w] / M_PI * sumDeriv;
+        }
+    }
+    return result;
+}
+
+QVector<double> LaplaceInversion::deHoog(const ComplexFunction& F, const QVector<double>& t,
+                                         int terms, double tol, double windowRatio, QVector<double>* derivative,
+                                         int maxTerms, double convergenceTol)
+{
+    m_evaluations = 0;
+    m_deHoogStatus = DeHoogStatus();
+    QVector<double> result(t.size(), 0.0);
+    if (derivative) *derivative = QVector<double>(t.size(), 0.0);
+    const int M0 = std::max(terms, 2);
+    const int MMax = std::max(maxTerms, M0);
+    if (!(tol > 0.0 && tol < 1.0)) tol = 1e-9;
+    if (windowRatio < 1.0) windowRatio = 1.0;
+
+    QVector<QVector<int>> windows = groupWindows(t, windowRatio);
+    if (windows.isEmpty()) return result;
+    const int nWindows = windows.size();
+
+    // 1. 每个窗口: T = 2 tmax，求值点 s_k = γ + iπk/T，k = 0..2M。
+    //    求值点与 M 无关，加阶时只需补算 k = 2M+1..2M' 的新节点
+    QVector<double> period(nWindows), shift(nWindows);
+    for (int w = 0; w < nWindows; ++w) {
+        double tMax = 0.0;
+        for (int idx : windows[w]) tMax = std::max(tMax, t[idx]);
+        period[w] = 2.0 * tMax;
+        shift[w] = -std::log(tol) / (2.0 * period[w]);
+    }
+    QVector<QVector<Complex>> values(nWindows), sValues(nWindows);
+    QVector<int> order(nWindows, 0);
+    // 把窗口 w 的阶数提高到 M，新节点汇总到 s/owner 中等待一次性并行求值
+    QVector<Complex> s;
+    QVector<int> owner;
+    auto extend = [&](int w, int M) {
+        for (int k = 2 * order[w] + (order[w] > 0 ? 1 : 0); k <= 2 * M; ++k) {
+            s.append(Complex(shift[w], M_PI * k / period[w]));
+            owner.append(w);
+        }
+        order[w] = M;
+    };
+    auto evaluatePending = [&]() {
+        QVector<Complex> fresh = evaluateAll(F, s);
+        for (int k = 0; k < s.size(); ++k) {
+            values[owner[k]].append(fresh[k]);
+            if (derivative) sValues[owner[k]].append(s[k] * fresh[k]);
+        }
+        s.clear();
+        owner.clear();
+    };
+
+    QVector<Complex> a(2 * MMax + 1), d(2 * MMax + 1);
+    QVector<Complex> e(2 * MMax + 1), q(2 * MMax + 1), eNext(2 * MMax + 1), qNext(2 * MMax + 1);
+    // 对窗口 w 的前 2M+1 个 Fourier 系数 (F 或 s·F 的值) 做 QD 连分式求和，timesT 时结果再乘以 t
+    auto invertWindow = [&](int w, const QVector<Complex>& coeffs, int M, bool timesT, QVector<double>& out) {
+        const int nTerms = 2 * M + 1;
+        // 3. Fourier 系数 (首项减半)
+        for (int k = 0; k < nTerms; ++k) a[k] = coeffs[k];
+        a[0] *= 0.5;
+
+        // 4. QD 算法求连分式系数 d_0..d_2M
+        //    e_0^(i) = 0，q_1^(i) = a_{i+1}/a_i
+        //    e_r^(i) = q_r^(i+1) - q_r^(i) + e_{r-1}^(i+1)
+        //    q_{r+1}^(i) = q_r^(i+1) e_r^(i+1) / e_r^(i)
+        std::fill(e.begin(), e.end(), Complex(0.0, 0.0));
+        for (int i = 0; i < nTerms - 1; ++i) {
+            q[i] = (std::abs(a[i]) > 0.0) ? a[i + 1] / a[i] : Complex(0.0, 0.0);
+        }
+        d[0] = a[0];
+        for (int r = 1; r <= M; ++r) {
+            int lenE = 2 * M - 2 * r + 1;
+            for (int i = 0; i < lenE; ++i) eNext[i] = q[i + 1] - q[i] + e[i + 1];
+            d[2 * r - 1] = -q[0];
+            d[2 * r] = -eNext[0];
+            if (r < M) {
+                int lenQ = 2 * M - 2 * r;
+                for (int i = 0; i < lenQ; ++i) {
+                    qNext[i] = (std::abs(eNext[i]) > 0.0) ? q[i + 1] * eNext[i + 1] / eNext[i] : Complex(0.0, 0.0);
+                }
+                std::swap(q, qNext);
+            }
+            std::swap(e, eNext);
+        }
+
+        // 5. 对窗口内每个时间点计算连分式的渐进分式 A_n/B_n
+        for (int idx : windows[w]) {
+            double tt = t[idx];
+            Complex z = std::exp(Complex(0.0, M_PI * tt / period[w]));
+            Complex Am2(0.0, 0.0), Bm2(1.0, 0.0);   // A_{-1}, B_{-1}
+            Complex Am1 = d[0], Bm1(1.0, 0.0);      // A_0, B_0
+            for (int k = 1; k < nTerms - 1; ++k) {
+                Complex An = Am1 + d[k] * z * Am2;
+                Complex Bn = Bm1 + d[k] * z * Bm2;
+                Am2 = Am1; Bm2 = Bm1;
+                Am1 = An; Bm1 = Bn;
+            }
+            // 末项用余项估计替代，进一步加速收敛
+            Complex h2M = 0.5 * (1.0 + (d[2 * M - 1] - d[2 * M]) * z);
+            Complex R2M = -h2M * (1.0 - std::sqrt(1.0 + d[2 * M] * z / (h2M * h2M)));
+            Complex A = Am1 + R2M * Am2;
+            Complex B = Bm1 + R2M * Bm2;
+
+            double value = std::exp(shift[w] * tt) / period[w] * (A / B).real();
+            if (timesT) value *= tt;
+            out[idx] = std::isfinite(value) ? value : 0.0;
+        }
+    };
+    // 窗口内两组结果的最大差，以窗口内 |f| 的最大值归一
+    auto windowChange = [&](int w, const QVector<double>& f, const QVector<double>& g) {
+        double diff = 0.0, scale = 0.0;
+        for (int idx : windows[w]) {
+            diff = std::max(diff, std::abs(f[idx] - g[idx]));
+            scale = std::max(scale, std::abs(f[idx]));
+        }
+        return (scale > 0.0) ? diff / scale : diff;
+    };
+
+    // 2. 收敛检查: 比较阶数 M 与 M - OrderStep 的结果 (后者只用已有节点的前缀，不增加求值)。
+    //    未收敛的窗口把 M 提高 OrderStep 并补算新节点，直到收敛或达到 maxTerms；
+    //    低阶时变化量未必单调下降，高阶时 QD 算法会受舍入误差影响而发散，因此每个窗口保留变化量最小的一次结果
+    for (int w = 0; w < nWindows; ++w) extend(w, M0);
+    evaluatePending();
+
+    QVector<double> current(t.size(), 0.0), lower(t.size(), 0.0);
+    QVector<double> currentDeriv(derivative ? t.size() : 0, 0.0), lowerDeriv(derivative ? t.size() : 0, 0.0);
+    QVector<double> bestChange(nWindows, std::numeric_limits<double>::infinity());
+    QVector<int> bestOrder(nWindows, M0);
+    QVector<int> active(nWindows);
+    for (int w = 0; w < nWindows; ++w) active[w] = w;
+    while (!active.isEmpty()) {
+        QVector<int> next;
+        for (int w : active) {
+            const int M = order[w];
+            invertWindow(w, values[w], M, false, current);
+            if (derivative) invertWindow(w, sValues[w], M, true, currentDeriv);
+            double change = 0.0;
+            const int ML = std::max(M - OrderStep, 2);
+            if (ML < M) {
+                invertWindow(w, values[w], ML, false, lower);
+                change = windowChange(w, current, lower);
+                if (derivative) {
+                    invertWindow(w, sValues[w], ML, true, lowerDeriv);
+                    change = std::max(change, windowChange(w, currentDeriv, lowerDeriv));
+                }
+            }
+            if (!std::isfinite(change)) change = std::numeric_limits<double>::max();
+            if (change < bestChange[w]) {
+                bestChange[w] = change;
+                bestOrder[w] = M;
+                for (int idx : windows[w]) {
+                    result[idx] = current[idx];
+                    if (derivative) (*derivative)[idx] = currentDeriv[idx];
+                }
+            }
+            // 变化量比最好的一次大出两个数量级时视为发散，停止加阶
+            if (change > convergenceTol && M < MMax && change <= 100.0 * bestChange[w]) {
+                extend(w, std::min(M + OrderStep, MMax));
+                next.append(w);
+            }
+        }
+        if (!next.isEmpty()) evaluatePending();
+        active = next;
+    }
+
+    // 3. 收敛状态: 各窗口最终采用的阶数与变化量取最大值
+    m_deHoogStatus.converged = true;
+    for (int w = 0; w < nWindows; ++w) {
+        m_deHoogStatus.terms = std::max(m_deHoogStatus.terms, bestOrder[w]);
+        m_deHoogStatus.change = std::max(m_deHoogStatus.change, bestChange[w]);
+        if (!(bestChange[w] <= convergenceTol)) m_deHoogStatus.converged = false;
+    }
+    return result;
+}
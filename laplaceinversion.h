@@ -0,0 +1,93 @@
+/*
+ * 文件名: laplaceinversion.h
+ * 文件作用: 复变量 Laplace 数值反演 (Talbot / de Hoog) 头文件
+ * 功能描述:
+ * 1. Talbot 型围道积分: 采用 Weideman-Trefethen 抛物线围道 s(u) = μ(1+iu)^2，梯形求和。
+ *    一条围道可同时服务一个时间窗 [t0, Λt0] 内的全部时间点，Laplace 解只需在围道节点上求值一次。
+ * 2. de Hoog-Knight-Stokes 算法: Bromwich 直线上的 Fourier 级数，用商差(QD)算法转为连分式加速收敛，
+ *    求值点全部位于右半平面，适用于 Laplace 解在左半平面不可解析延拓的模型。
+ * 3. 时间点按时间窗分组，全部窗口的求值点汇总后一次性并行计算，并统计求值次数。
+ * 4. Stehfest 反演仍保留在各求解器内部 (实变量)，本类只处理需要复变量解的反演方法。
+ * 5. 供 ModelSolver01_06 与 ModelSolver19_36 的 calculatePDandDeriv 共用。
+ * 6. 可选同时给出压力导数 t·df/dt = t·L^-1[s·F(s)] (f(0)=0)，与 f 共用同一组求值点，不增加 F 的求值次数。
+ * 7. de Hoog 阶数自适应: 以 M 与 M-4 两阶结果的差作为收敛判据，未收敛时逐步加阶 (只补算新节点)，
+ *    并记录最终阶数、变化量与是否收敛，供求解器提示用户。
+ */
+
+#ifndef LAPLACEINVERSION_H
+#define LAPLACEINVERSION_H
+
+#include <QVector>
+#include <complex>
+#include <functional>
+
+class LaplaceInversion
+{
+public:
+    // 反演方法 (与 ModelSolverParams::inversion 取值对应)
+    enum Method {
+        Stehfest = 0,   // 实变量 Stehfest (各求解器内部实现)
+        Talbot = 1,     // 抛物线围道 Talbot 型反演
+        DeHoog = 2      // de Hoog QD 加速 Fourier 级数
+    };
+
+    // 复 Laplace 空间解 F(s) (可并行调用)
+    typedef std::function<std::complex<double>(const std::complex<double>&)> ComplexFunction;
+
+    // 缺省时间窗宽度 Λ
+    static constexpr double DefaultWindowRatio = 5.0;
+    // de Hoog 收敛检查的阶数步长 (比较 M 与 M - OrderStep)
+    static constexpr int OrderStep = 4;
+
+    // 最近一次 de Hoog 反演的收敛状态
+    struct DeHoogStatus {
+        int terms = 0;          // 各时间窗最终采用的最大阶数 M
+        double change = 0.0;    // 各时间窗 M 与 M-4 两阶结果的最大相对差
+        bool converged = true;  // 全部时间窗的变化量均不超过容差
+    };
+
+    LaplaceInversion();
+
+    /**
+     * @brief Talbot 型反演
+     * @param F Laplace 空间解
+     * @param t 时间点 (t<=1e-10 的点返回 0)
+     * @param nodes 每条围道的半边节点数 N (共 N+1 次求值，利用共轭对称)
+     * @param windowRatio 时间窗宽度 Λ = tmax/tmin
+     * @param derivative 非空时同时输出 t·df/dt (同一组求值点)
+     */
+    QVector<double> talbot(const ComplexFunction& F, const QVector<double>& t,
+                           int nodes, double windowRatio = DefaultWindowRatio,
+                           QVector<double>* derivative = nullptr);
+
+    /**
+     * @brief de Hoog 反演
+     * @param terms 初始 QD 阶数 M (每个时间窗 2M+1 次求值)
+     * @param tol 离散化误差目标，决定 Bromwich 直线位置 γ = -ln(tol)/(2T)
+     * @param derivative 非空时同时输出 t·df/dt (同一组求值点)
+     * @param maxTerms 阶数上限；不大于 terms 时不加阶，只给出收敛状态
+     * @param convergenceTol M 与 M-4 两阶结果的相对差小于该值时视为收敛
+     */
+    QVector<double> deHoog(const ComplexFunction& F, const QVector<double>& t,
+                           int terms, double tol, double windowRatio = DefaultWindowRatio,
+                           QVector<double>* derivative = nullptr,
+                           int maxTerms = 0, double convergenceTol = 1e-4);
+
+    // 最近一次反演中 F 的实际求值次数
+    int evaluationCount() const;
+    // 最近一次 de Hoog 反演的收敛状态
+    DeHoogStatus deHoogStatus() const;
+
+private:
+    // 将 t>1e-10 的时间点按时间窗 [t0, Λt0] 分组，返回各组的下标
+    static QVector<QVector<int>> groupWindows(const QVector<double>& t, double windowRatio);
+
+    // 并行计算全部求值点，非有限值按 0 处理
+    QVector<std::complex<double>> evaluateAll(const ComplexFunction& F,
+                                              const QVector<std::complex<double>>& s);
+
+    int m_evaluations;
+    DeHoogStatus m_deHoogStatus;
+};
+
+#endif // LAPLACEINVERSION_H
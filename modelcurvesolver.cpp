@@ -0,0 +1,286 @@
+/*
+ * 文件名: modelcurvesolver.cpp
+ * 文件作用: 压裂水平井复合模型的曲线级求解基类实现
+ * 功能描述:
+ * 1. 理论曲线: 有因次时间/压力换算、无因次曲线缓存、取消标志，Laplace 反演与压力导数由 calculatePDandDeriv 完成。
+ * 2. calculatePDandDeriv: Stehfest 的 (时间点 × 系数项) 求值以细粒度任务提交到全局工作窃取调度器，
+ *    可选 Laplace 解插值；Talbot / de Hoog 复变量反演同一时间窗共用一组求值点，de Hoog 未收敛时提示一次。
+ * 3. 两组模型的差别 (Stehfest 阶数上限、是否只用 de Hoog) 由构造时传入的 ModelCurvePolicy 给出。
+ * 4. 每条曲线 (及每次灵敏度计算) 使用局部的 BemKernelStats 计数，完成后在互斥锁下整体替换统计快照；
+ *    被取消的曲线不替换快照。
+ */
+
+#include "modelcurvesolver.h"
+#include "pressurederivativecalculator.h"
+#include "laplaceinterpolator.h"
+#include "laplaceinversion.h"
+#include "bemworkspace.h"
+#include "taskscheduler.h"
+#include "stehfesttable.h"
+
+#include <cmath>
+#include <algorithm>
+#include <QDebug>
+#include <QMutexLocker>
+
+ModelCurveSolver::ModelCurveSolver(const ModelKernel* kernel, const ModelCurvePolicy& policy, const QString& modelName)
+    : m_kernel(kernel), m_policy(policy), m_modelName(modelName) {
+}
+
+ModelCurveSolver::~ModelCurveSolver() {}
+
+void ModelCurveSolver::publishStatistics(const BemKernelStats& stats)
+{
+    CurveStatistics snapshot;
+    snapshot.quadEvaluations = stats.quadEvaluations.load();
+    snapshot.bemSolves = stats.bemSolves.load();
+    snapshot.workspaceAllocations = stats.workspaceAllocations.load();
+    for (int i = 0; i < FarFieldQuadrature::TierCount; ++i) snapshot.farFieldTiers[i] = stats.farFieldTiers[i].load();
+    snapshot.asymptoticShortcuts = stats.asymptoticShortcuts.load();
+    snapshot.asymptoticMaxDeviation = stats.asymptoticMaxDeviation.load();
+    QMutexLocker locker(&m_statsMutex);
+    m_lastStats = snapshot;
+}
+
+ModelCurveSolver::CurveStatistics ModelCurveSolver::lastStatistics() const
+{
+    QMutexLocker locker(&m_statsMutex);
+    return m_lastStats;
+}
+
+long long ModelCurveSolver::lastQuadratureEvaluations() const { return lastStatistics().quadEvaluations; }
+
+long long ModelCurveSolver::lastBemSolves() const { return lastStatistics().bemSolves; }
+
+long long ModelCurveSolver::lastWorkspaceAllocations() const { return lastStatistics().workspaceAllocations; }
+
+QVector<long long> ModelCurveSolver::lastFarFieldTierCounts() const { return lastStatistics().farFieldTiers; }
+
+long long ModelCurveSolver::lastAsymptoticShortcuts() const { return lastStatistics().asymptoticShortcuts; }
+
+double ModelCurveSolver::lastAsymptoticMaxDeviation() const { return lastStatistics().asymptoticMaxDeviation; }
+
+QVector<double> ModelCurveSolver::generateLogTimeSteps(int count, double startExp, double endExp)
+{
+    QVector<double> t;
+    if (count <= 0) return t;
+    t.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        double exponent = startExp + (endExp - startExp) * i / (count - 1);
+        t.append(pow(10.0, exponent));
+    }
+    return t;
+}
+
+ModelCurveData ModelCurveSolver::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime,
+                                                           const std::atomic<bool>* cancel)
+{
+    QVector<double> tPoints = providedTime;
+    if (tPoints.isEmpty()) tPoints = generateLogTimeSteps(100, -3.0, 3.0);
+
+    double phi = params.value("phi", 0.05);
+    double mu = params.value("mu", 0.5);
+    double B = params.value("B", 1.05);
+    double Ct = params.value("Ct", 5e-4);
+    double q = params.value("q", 5.0);
+    double h = params.value("h", 20.0);
+    double kf = params.value("kf", 1e-3);
+    double L = params.value("L", 1000.0);
+
+    if (L < 1e-9) L = 1000.0;
+    if (phi < 1e-12 || mu < 1e-12 || Ct < 1e-12 || kf < 1e-12) {
+        return std::make_tuple(tPoints, QVector<double>(tPoints.size(), 0.0), QVector<double>(tPoints.size(), 0.0));
+    }
+
+    double td_coeff = 14.4 * kf / (phi * mu * Ct * pow(L, 2));
+    QVector<double> tD_vec;
+    tD_vec.reserve(tPoints.size());
+    for(double t : tPoints) tD_vec.append(td_coeff * t);
+
+    // 本条曲线的统计 (并行任务共享，与同一求解器上并发的其他曲线互不干扰)
+    BemKernelStats stats;
+
+    // 在界面边界处一次性编译参数块，内核中不再进行字符串查找
+    ModelSolverParams calcParams = ModelSolverParams::fromMap(params);
+    int N = calcParams.N;
+    if (N < 4 || N > m_policy.maxStehfestN || N % 2 != 0) N = 10;
+    calcParams.N = N;
+
+    QVector<double> PD_vec, Deriv_vec;
+    // 无因次曲线缓存 (curveCache=1 时开启，缺省关闭): 形状参数未变时，压力尺度参数 (q/B/h) 变化直接复用 PD，
+    // 时间尺度参数 (phi/Ct) 变化在缓存曲线上插值 (夹层型模型的 PCHIP 插值误差可达 1e-2)，均无需重新进行 Laplace 反演；
+    // curveCacheInterp=0 时只接受时间点完全一致的命中 (拟合雅可比矩阵的扰动曲线不允许读取插值结果)
+    bool useCache = params.value("curveCache", 0.0) > 0.5;
+    bool allowInterp = params.value("curveCacheInterp", 1.0) > 0.5;
+    if (!useCache) {
+        calculatePDandDeriv(tD_vec, calcParams, stats, PD_vec, Deriv_vec, cancel);
+        if (cancel && cancel->load()) return ModelCurveData();
+    } else {
+        // 解析导数 t·dPD/dt 与时间尺度无关，和 PD 一起缓存、一起插值
+        bool analytic = calcParams.analyticDeriv;
+        if (!m_curveCache.lookup(params, tD_vec, PD_vec, analytic ? &Deriv_vec : nullptr, allowInterp)) {
+            // 完整计算时两端各补两个点写入缓存，补点不参与本次输出
+            QVector<double> tD_calc = DimensionlessCurveCache::paddedTimes(tD_vec);
+            QVector<double> PD_calc, Deriv_calc;
+            calculatePDandDeriv(tD_calc, calcParams, stats, PD_calc, Deriv_calc, cancel);
+            // 已作废的计算只求值了部分点，结果不可用，更不能写入缓存
+            if (cancel && cancel->load()) return ModelCurveData();
+            m_curveCache.insert(params, tD_calc, PD_calc, analytic ? Deriv_calc : QVector<double>());
+            int front = (tD_calc.size() > tD_vec.size()) ? DimensionlessCurveCache::PadPoints : 0;
+            PD_vec = PD_calc.mid(front, tD_vec.size());
+            if (analytic) Deriv_vec = Deriv_calc.mid(front, tD_vec.size());
+        }
+        // Bourdet 模式: 导数只在本次请求的时间点上求取
+        if (!analytic) {
+            if (tD_vec.size() > 2) {
+                Deriv_vec = PressureDerivativeCalculator::calculateBourdetDerivative(tD_vec, PD_vec, 0.1);
+            } else {
+                Deriv_vec = QVector<double>(tD_vec.size(), 0.0);
+            }
+        }
+    }
+
+    // 渐近捷径校验模式: 输出本条曲线的校验次数与最大相对偏差
+    if (calcParams.asymptoticVerify && stats.asymptoticShortcuts > 0) {
+        qDebug() << "渐近捷径校验:" << stats.asymptoticShortcuts.load() << "次, 最大相对偏差" << stats.asymptoticMaxDeviation.load();
+    }
+    publishStatistics(stats);
+
+    double p_coeff = 1.842e-3 * q * mu * B / (kf * h);
+    QVector<double> finalP(tPoints.size()), finalDP(tPoints.size());
+    for(int i=0; i<tPoints.size(); ++i) {
+        finalP[i] = p_coeff * PD_vec[i];
+        finalDP[i] = p_coeff * Deriv_vec[i];
+    }
+    return std::make_tuple(tPoints, finalP, finalDP);
+}
+
+bool ModelCurveSolver::calculateSensitivity(const QMap<QString, double>& params, const QVector<double>& time,
+                                       const QStringList& names, CurveSensitivity::Result& out)
+{
+    // Stehfest 阶数上限与 calculateTheoreticalCurve 的校验一致
+    BemKernelStats stats;
+    if (!CurveSensitivity::compute(m_kernel, m_context, stats, params, time, names, m_policy.maxStehfestN, out)) return false;
+    publishStatistics(stats);
+    return true;
+}
+
+void ModelCurveSolver::calculatePDandDeriv(const QVector<double>& tD, const ModelSolverParams& params, BemKernelStats& stats,
+                                           QVector<double>& outPD, QVector<double>& outDeriv,
+                                           const std::atomic<bool>* cancel)
+{
+    int numPoints = tD.size();
+    outPD.resize(numPoints);
+    outDeriv.resize(numPoints);
+
+    int N = params.N;
+    double ln2 = 0.6931471805599453;
+    double gamaD = params.gamaD;
+
+    // 压敏变换: pd = -ln(1 - γD*pd)/γD
+    auto applyGamaD = [gamaD](double pd_real) {
+        if (std::abs(gamaD) > 1e-9) {
+            double arg = 1.0 - gamaD * pd_real;
+            if (arg > 1e-12) pd_real = -1.0 / gamaD * std::log(arg);
+        }
+        return pd_real;
+    };
+    // 压敏变换的导数 (链式法则): t·dpd/dt = (t·dpd0/dt) / (1 - γD*pd0)
+    auto applyGamaDDeriv = [gamaD](double pd_real, double deriv_real) {
+        if (std::abs(gamaD) > 1e-9) {
+            double arg = 1.0 - gamaD * pd_real;
+            if (arg > 1e-12) deriv_real /= arg;
+        }
+        return deriv_real;
+    };
+    // 解析导数: 与 PD 共用同一组 Laplace 求值 (t·dPD/dt = t·L^-1[s·F(s)])，不再对 PD 做 Bourdet 差分
+    const bool analytic = params.analyticDeriv;
+    // 取消标志: 置位后剩余的 Laplace 求值直接跳过 (结果由调用方丢弃)
+    auto cancelled = [cancel]() { return cancel && cancel->load(std::memory_order_relaxed); };
+
+    if (params.inversion != LaplaceInversion::Stehfest) {
+        // [复变量反演] Talbot / de Hoog: 同一时间窗内的全部时间点共用一组复 Laplace 求值点；
+        // 策略要求只用 de Hoog 时 (夹层型 Laplace 解在左半平面指数增长)，Talbot 请求改用 de Hoog 并提示一次
+        bool talbot = (params.inversion == LaplaceInversion::Talbot);
+        if (talbot && m_policy.deHoogOnly) {
+            talbot = false;
+            if (!m_talbotOverrideWarned.exchange(true)) {
+                qWarning() << m_modelName << ": Laplace 解在左半平面指数增长，所选 Talbot 反演不适用，已改用 de Hoog 反演";
+            }
+        }
+        LaplaceInversion inverter;
+        auto F = [&](const std::complex<double>& s) {
+            return cancelled() ? std::complex<double>(0.0) : m_kernel->laplaceComplex(s, params, m_context, stats);
+        };
+        QVector<double> dpd;
+        QVector<double>* derivOut = analytic ? &dpd : nullptr;
+        QVector<double> pd = talbot
+                ? inverter.talbot(F, tD, params.talbotNodes, LaplaceInversion::DefaultWindowRatio, derivOut)
+                : inverter.deHoog(F, tD, params.deHoogTerms, 1e-10, LaplaceInversion::DefaultWindowRatio, derivOut,
+                                  params.deHoogMaxTerms, params.deHoogTol);
+        if (!talbot) {
+            LaplaceInversion::DeHoogStatus status = inverter.deHoogStatus();
+            if (!status.converged && !cancelled() && !m_deHoogWarned.exchange(true)) {
+                qWarning() << m_modelName << ": de Hoog 反演未收敛，阶数" << status.terms
+                           << "时相邻两阶结果的最大相对差" << status.change << "(容差" << params.deHoogTol << ")";
+            }
+        }
+        for (int k = 0; k < numPoints; ++k) {
+            outPD[k] = (tD[k] <= 1e-10) ? 0.0 : applyGamaD(pd[k]);
+            if (analytic) outDeriv[k] = (tD[k] <= 1e-10) ? 0.0 : applyGamaDDeriv(pd[k], dpd[k]);
+        }
+    } else {
+        // [插值模式] 先在对数 z 网格上自适应建立 pf 插值表，再对全部 Stehfest 横坐标插值
+        LaplaceInterpolator interp;
+        if (params.laplaceInterp) {
+            double tMin = 0.0, tMax = 0.0;
+            for (double t : tD) {
+                if (t <= 1e-10) continue;
+                if (tMax == 0.0 || t < tMin) tMin = t;
+                if (t > tMax) tMax = t;
+            }
+            if (tMax > 0.0) {
+                interp.build([&](double z) { return cancelled() ? 0.0 : m_kernel->laplace(z, params, m_context, stats); },
+                             ln2 / tMax, N * ln2 / tMin, params.laplaceInterpTol);
+            }
+        }
+
+        // [任务展开] (时间点 × Stehfest 项) 展开为独立任务交给工作窃取调度器，
+        // 与外层任务 (雅可比扰动列等) 统一调度；系数查编译期常量表，任务间不共享可变状态
+        const long double* stehfest = StehfestTable::rowLong(N);
+        QVector<double> pfValues(numPoints * N, 0.0);
+        auto evaluateTerm = [&](int task) {
+            double t = tD[task / N];
+            if (t <= 1e-10 || cancelled()) return;
+            double z = (task % N + 1) * ln2 / t;
+            double pf = interp.isValid() ? interp.value(z) : m_kernel->laplace(z, params, m_context, stats);
+            if (std::isnan(pf) || std::isinf(pf)) pf = 0.0;
+            pfValues[task] = pf;
+        };
+        // 插值求值很廉价，按较大粒度切分；直接求值时每项即一次边界元求解
+        TaskScheduler::instance().parallelFor(numPoints * N, evaluateTerm, interp.isValid() ? 256 : 1);
+
+        for (int k = 0; k < numPoints; ++k) {
+            double t = tD[k];
+            if (t <= 1e-10) { outPD[k] = 0.0; outDeriv[k] = 0.0; continue; }
+            // 系数正负交替、量级可达 1e9，以 long double 累加减小抵消误差
+            // 导数项: t·(ln2/t)·Σ V_m s_m F(s_m)，s_m = m·ln2/t，即 (ln2)²/t · Σ m V_m F(s_m)
+            long double pd_val = 0.0L, deriv_val = 0.0L;
+            for (int m = 1; m <= N; ++m) {
+                long double term = stehfest[m] * pfValues[k * N + m - 1];
+                pd_val += term;
+                deriv_val += m * term;
+            }
+            double pd0 = (double)pd_val * ln2 / t;
+            outPD[k] = applyGamaD(pd0);
+            if (analytic) outDeriv[k] = applyGamaDDeriv(pd0, (double)deriv_val * ln2 * ln2 / t);
+        }
+    }
+
+    if (analytic) return;
+    if (numPoints > 2) {
+        outDeriv = PressureDerivativeCalculator::calculateBourdetDerivative(tD, outPD, 0.1);
+    } else {
+        outDeriv.fill(0.0);
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * 文件名: modelcurvesolver.h
+ * 文件作用: 压裂水平井复合模型的曲线级求解基类头文件
+ * 功能描述:
+ * 1. ModelCurveSolver 承担两组求解器 (ModelSolver01_06 / ModelSolver19_36) 共有的曲线级计算:
+ *    有因次/无因次换算、Stehfest 或复变量反演、解析导数与压敏变换、无因次曲线缓存、取消标志、
+ *    解析灵敏度入口及最近一次曲线的统计。
+ * 2. 两组模型的差别只在曲线级策略 ModelCurvePolicy 中给出: Stehfest 阶数上限、
+ *    复变量反演是否只能使用 de Hoog (夹层型 Laplace 解在左半平面指数增长，Talbot 围道不适用)。
+ * 3. Laplace 解由构造时绑定的编译期特化内核 (modelkernelregistry.h) 给出，派生类只负责模型编号、名称与策略。
+ * 4. 工作区池由同一求解器上的全部曲线共享；统计按曲线各用一份 BemKernelStats，经 calculatePDandDeriv 传入内核，
+ *    曲线完成后整体替换为 last* 接口读取的快照，并发的曲线 (如雅可比扰动列) 不再互相清零。
+ */
+
+#ifndef MODELCURVESOLVER_H
+#define MODELCURVESOLVER_H
+
+#include <QMap>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <tuple>
+#include <complex>
+#include <atomic>
+#include <QMutex>
+#include "modelsolverparams.h"
+#include "dimensionlesscurvecache.h"
+#include "modelkernelregistry.h"
+#include "curvesensitivity.h"
+
+// 类型定义: <时间序列(t), 压力序列(Dp), 导数序列(Dp')>
+using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
+
+// 曲线级求解策略 (两组模型仅在此不同)
+struct ModelCurvePolicy
+{
+    int maxStehfestN;       // Stehfest 阶数上限，超出或非法 (奇数、小于 4) 时取 10
+    bool deHoogOnly;        // 复变量反演只使用 de Hoog，请求 Talbot 时提示一次并改用 de Hoog
+};
+
+class ModelCurveSolver
+{
+public:
+    ModelCurveSolver(const ModelKernel* kernel, const ModelCurvePolicy& policy, const QString& modelName);
+    virtual ~ModelCurveSolver();
+
+    // 以下统计均取最近一次完成的理论曲线 (或灵敏度) 计算
+    // 最近一次理论曲线计算中边界元积分的被积函数求值次数
+    long long lastQuadratureEvaluations() const;
+
+    // 最近一次理论曲线计算中的边界元求解次数 (原实现每次求解约 8 次堆分配)
+    long long lastBemSolves() const;
+    // 最近一次理论曲线计算中工作区缓冲区的实际分配次数 (复用时为 0)
+    long long lastWorkspaceAllocations() const;
+    // 最近一次理论曲线计算中远场分级积分各级别的段对数 (下标为 FarFieldQuadrature::Tier)
+    QVector<long long> lastFarFieldTierCounts() const;
+    // 最近一次理论曲线计算中使用渐近解的次数 (校验模式下为校验次数)
+    long long lastAsymptoticShortcuts() const;
+    // 校验模式下渐近解与完整边界元解的最大相对偏差
+    double lastAsymptoticMaxDeviation() const;
+
+    // 计算理论曲线接口 (cancel 非空且被置位时尽快中止，返回空曲线且不写入缓存)
+    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>(),
+                                             const std::atomic<bool>* cancel = nullptr);
+
+    // 理论曲线及其对 names 中各参数的解析灵敏度 (复变量反演、Bourdet 导数模式下返回 false，由调用方退回差分)
+    bool calculateSensitivity(const QMap<QString, double>& params, const QVector<double>& time,
+                              const QStringList& names, CurveSensitivity::Result& out);
+
+    // 生成时间步
+    static QVector<double> generateLogTimeSteps(int count, double startExp, double endExp);
+
+private:
+    // 一条曲线的统计快照 (BemKernelStats 的非原子副本)
+    struct CurveStatistics
+    {
+        long long quadEvaluations = 0;
+        long long bemSolves = 0;
+        long long workspaceAllocations = 0;
+        QVector<long long> farFieldTiers = QVector<long long>(FarFieldQuadrature::TierCount, 0);
+        long long asymptoticShortcuts = 0;
+        double asymptoticMaxDeviation = 0.0;
+    };
+
+    // 曲线在 stats 中计数 (该曲线的并行任务共享)
+    void calculatePDandDeriv(const QVector<double>& tD, const ModelSolverParams& params, BemKernelStats& stats,
+                             QVector<double>& outPD, QVector<double>& outDeriv,
+                             const std::atomic<bool>* cancel = nullptr);
+    // 以完成的曲线的统计替换快照
+    void publishStatistics(const BemKernelStats& stats);
+    CurveStatistics lastStatistics() const;
+
+private:
+    const ModelKernel* m_kernel;               // 按模型特征特化的 Laplace 解内核
+    ModelCurvePolicy m_policy;
+    QString m_modelName;                       // 提示信息中使用的模型名称
+    DimensionlessCurveCache m_curveCache;      // 无因次曲线缓存 (按形状参数)
+    BemKernelContext m_context;                // 内核工作区池 (全部曲线与并行任务共享)
+    mutable QMutex m_statsMutex;               // 保护 m_lastStats
+    CurveStatistics m_lastStats;               // 最近一次完成的曲线的统计
+    std::atomic<bool> m_talbotOverrideWarned{false}; // 已提示 Talbot 请求改用 de Hoog (每个求解器只提示一次)
+    std::atomic<bool> m_deHoogWarned{false};   // 已提示 de Hoog 未收敛 (每个求解器只提示一次)
+};
+
+#endif // MODELCURVESOLVER_H
@@ -0,0 +1,64 @@
+/*
+ * 文件名: modelkernelregistry.cpp
+ * 文件作用: 模型内核注册表与内核运行环境实现
+ * 功能描述:
+ * 1. 以 std::integer_sequence 展开 0-35，为每个模型编号实例化 CompositeKernel<ModelTraitsFor<id>>，
+ *    生成静态只读的内核表 (首次查询时构造)。
+ * 2. BemKernelContext 的构造；BemKernelStats 的构造与远场分级统计累加。
+ */
+
+#include "modelkernelregistry.h"
+#include "compositekernel.h"
+#include "bemworkspace.h"
+
+#include <array>
+#include <utility>
+
+namespace {
+
+template <int Id>
+ModelKernel makeKernel()
+{
+    using Kernel = CompositeKernel<ModelTraitsFor<Id>>;
+    return ModelKernel{ modelTraitsInfo(Id),
+                        static_cast<ModelKernel::RealLaplace>(&Kernel::laplace),
+                        static_cast<ModelKernel::ComplexLaplace>(&Kernel::laplace),
+                        &Kernel::sensitivity };
+}
+
+template <int... Ids>
+std::array<ModelKernel, sizeof...(Ids)> makeKernelTable(std::integer_sequence<int, Ids...>)
+{
+    return {{ makeKernel<Ids>()... }};
+}
+
+} // namespace
+
+const ModelKernel* ModelKernelRegistry::kernel(int id)
+{
+    static const std::array<ModelKernel, ModelTraitsMap::ModelCount> table =
+            makeKernelTable(std::make_integer_sequence<int, ModelTraitsMap::ModelCount>());
+    if (id < 0 || id >= ModelTraitsMap::ModelCount) return nullptr;
+    return &table[id];
+}
+
+BemKernelContext::BemKernelContext()
+    : workspaces(new BemWorkspacePool)
+{
+}
+
+BemKernelContext::~BemKernelContext() {}
+
+BemKernelStats::BemKernelStats()
+    : quadEvaluations(0), bemSolves(0), workspaceAllocations(0),
+      asymptoticShortcuts(0), asymptoticMaxDeviation(0.0)
+{
+    for (auto& count : farFieldTiers) count = 0;
+}
+
+void BemKernelStats::addFarFieldStats(const FarFieldQuadrature::Stats& stats)
+{
+    for (int i = 0; i < FarFieldQuadrature::TierCount; ++i) {
+        if (stats.pairs[i]) farFieldTiers[i] += stats.pairs[i];
+    }
+}
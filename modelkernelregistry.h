@@ -0,0 +1,96 @@
+/*
+ * 文件名: modelkernelregistry.h
+ * 文件作用: 36 种模型 Laplace 解内核的注册表头文件
+ * 功能描述:
+ * 1. BemKernelContext: 内核运行环境 (边界元工作区池)，由求解器持有，同一求解器上的全部曲线与并行任务共享。
+ *    BemKernelStats: 一条曲线的统计 (积分求值次数、边界元求解次数、工作区分配次数、远场分级段对数、
+ *    渐近捷径次数与校验偏差)，由发起曲线计算的一方持有并传入内核，该曲线的并行任务共享 (计数均为原子量)；
+ *    同一求解器上并发的曲线各用一份，互不清零。
+ * 2. ModelKernel: 一个模型的特征与实/复 Laplace 解函数指针，函数指针指向按编译期特征
+ *    特化的 CompositeKernel<ModelTraitsFor<id>> 实例，内核中不再有模型编号判断。
+ * 3. ModelKernelRegistry: 模型编号 -> 内核的查表 (编译期生成全部 36 个实例)，
+ *    ModelManager 按编号查表一次确定求解器分组，求解器构造时绑定对应内核。
+ * 4. 内核另提供实变量 Laplace 解对形状参数的灵敏度 (一次边界元求解同时给出解与全部导数)，供拟合雅可比矩阵使用。
+ * 5. 灵敏度函数可选给出对 Laplace 变量的导数 (dz 非空时)，时间尺度参数的灵敏度由此求得。
+ */
+
+#ifndef MODELKERNELREGISTRY_H
+#define MODELKERNELREGISTRY_H
+
+#include <atomic>
+#include <memory>
+#include <complex>
+#include <algorithm>
+#include <cmath>
+
+#include "modeltraits.h"
+#include "modelsolverparams.h"
+#include "farfieldquadrature.h"
+
+class BemWorkspacePool;
+
+struct BemKernelContext
+{
+    BemKernelContext();
+    ~BemKernelContext();
+    BemKernelContext(const BemKernelContext&) = delete;
+    BemKernelContext& operator=(const BemKernelContext&) = delete;
+
+    std::unique_ptr<BemWorkspacePool> workspaces;         // 边界元工作区池 (每个并行任务借用一个)
+};
+
+struct BemKernelStats
+{
+    BemKernelStats();
+    BemKernelStats(const BemKernelStats&) = delete;
+    BemKernelStats& operator=(const BemKernelStats&) = delete;
+
+    std::atomic<long long> quadEvaluations;                // 积分求值计数
+    std::atomic<long long> bemSolves;                      // 边界元求解次数
+    std::atomic<long long> workspaceAllocations;           // 工作区缓冲区的实际分配次数 (复用时为 0)
+    std::atomic<long long> farFieldTiers[FarFieldQuadrature::TierCount]; // 远场分级积分各级别段对数
+    std::atomic<long long> asymptoticShortcuts;            // 渐近解命中次数
+    std::atomic<double> asymptoticMaxDeviation;            // 校验模式下的最大相对偏差
+
+    // 累加一次边界元组装的远场分级统计 (并行安全)
+    void addFarFieldStats(const FarFieldQuadrature::Stats& stats);
+
+    // 渐近解校验: 命中渐近区间时记录与完整解的偏差 (并行任务间取最大值)，返回完整解
+    template <typename T>
+    T verifyAsymptotic(bool asymptotic, const T& pwAsymptotic, const T& pwFull)
+    {
+        if (asymptotic) {
+            double deviation = std::abs(pwAsymptotic - pwFull) / std::max(std::abs(pwFull), 1e-300);
+            asymptoticShortcuts++;
+            double previous = asymptoticMaxDeviation.load();
+            while (deviation > previous && !asymptoticMaxDeviation.compare_exchange_weak(previous, deviation)) {}
+        }
+        return pwFull;
+    }
+};
+
+struct ModelKernel
+{
+    using RealLaplace = double (*)(double z, const ModelSolverParams& p, BemKernelContext& ctx, BemKernelStats& stats);
+    using ComplexLaplace = std::complex<double> (*)(const std::complex<double>& z, const ModelSolverParams& p,
+                                                    BemKernelContext& ctx, BemKernelStats& stats);
+    // 返回实变量 Laplace 解，grad[k] 为对 ModelSolverParams::SensitivityField k 的导数
+    // (mask 第 k 位为 0 的参数不求，grad 长度为 SensitivityCount)；dz 非空时另给出对 z 的导数
+    using RealSensitivity = double (*)(double z, const ModelSolverParams& p, BemKernelContext& ctx, BemKernelStats& stats,
+                                       unsigned mask, double* grad, double* dz);
+
+    ModelTraitsInfo traits;
+    RealLaplace laplace;            // 实变量 Laplace 解 (Stehfest)
+    ComplexLaplace laplaceComplex;  // 复变量 Laplace 解 (Talbot / de Hoog)
+    RealSensitivity sensitivity;    // 实变量 Laplace 解及其对形状参数的导数
+};
+
+class ModelKernelRegistry
+{
+public:
+    // 模型编号 (0-35) 对应的内核，编号越界时返回 nullptr
+    static const ModelKernel* kernel(int id);
+    static int count() { return ModelTraitsMap::ModelCount; }
+};
+
+#endif // MODELKERNELREGISTRY_H
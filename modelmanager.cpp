@@ -6,6 +6,12 @@
  * 2. 实现了模型计算的分发逻辑。
  * 3. [修改] 优化参数传递，直接从全局 ModelParameter 读取物理常数，
  * 并设置符合要求的模型初始猜测值。
+ * 4. 理论曲线计算经模型内核注册表按编号分发，不再逐段判断模型编号范围。
+ * 5. 批量理论曲线计算: 求解器在调度前串行创建，按 (模型, 形状参数) 分组后交给全局调度器并行。
+ * 6. 曲线灵敏度计算与理论曲线计算同样按注册表分发。
+ * 7. 批量计算缺省开启曲线缓存的完全一致复用 (batchCurveParams)，不读取插值曲线。
+ * 8. 单条理论曲线计算转发取消标志。
+ * 9. 移除全局高精度开关 setHighPrecision: 拟合精度由保真度阶梯经参数字典传给求解器，模型界面的精度不受拟合影响。
  */
 
 #include "modelmanager.h"
@@ -14,12 +20,17 @@
 #include "wt_modelwidget.h"
 #include "modelsolver01-06.h"
 #include "modelsolver19_36.h"
+#include "modelkernelregistry.h"
+#include "dimensionlesscurvecache.h"
+#include "taskscheduler.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QGroupBox>
 #include <QDebug>
+#include <QMutex>
+#include <QHash>
 #include <cmath>
 
 ModelManager::ModelManager(QWidget* parent)
@@ -91,6 +102,8 @@ WT_ModelWidget* ModelManager::ensureWidget(ModelType type)
 
 ModelSolver01_06* ModelManager::ensureSolverGroup1(int index)
 {
+    // 后台计算 (拟合、滚轮预览) 与界面线程可能同时首次请求同一求解器
+    QMutexLocker locker(&m_solverMutex);
     if (index < 0 || index >= m_solversGroup1.size()) return nullptr;
     if (m_solversGroup1[index] == nullptr) {
         m_solversGroup1[index] = new ModelSolver01_06((ModelSolver01_06::ModelType)index);
@@ -100,6 +113,7 @@ ModelSolver01_06* ModelManager::ensureSolverGroup1(int index)
 
 ModelSolver19_36* ModelManager::ensureSolverGroup2(int index)
 {
+    QMutexLocker locker(&m_solverMutex);
     if (index < 0 || index >= m_solversGroup2.size()) return nullptr;
     if (m_solversGroup2[index] == nullptr) {
         m_solversGroup2[index] = new ModelSolver19_36((ModelSolver19_36::ModelType)index);
@@ -122,20 +136,130 @@ void ModelManager::switchToModel(ModelType modelType)
 
 ModelCurveData ModelManager::calculateTheoreticalCurve(ModelType type,
                                                        const QMap<QString, double>& params,
-                                                       const QVector<double>& providedTime)
+                                                       const QVector<double>& providedTime,
+                                                       const std::atomic<bool>* cancel)
 {
-    int id = (int)type;
-    if (id >= 0 && id <= 17) {
-        ModelSolver01_06* solver = ensureSolverGroup1(id);
-        if (solver) return solver->calculateTheoreticalCurve(params, providedTime);
-    }
-    else if (id >= 18 && id <= 35) {
-        ModelSolver19_36* solver = ensureSolverGroup2(id - 18);
-        if (solver) return solver->calculateTheoreticalCurve(params, providedTime);
+    // 按模型编号查注册表一次: 内区夹层型 (高刚性) 由 19-36 组求解器处理 (N 上限与 de Hoog 反演策略)，
+    // 其余由 1-18 组处理；求解器内部直接调用已绑定的特化内核
+    const ModelKernel* kernel = ModelKernelRegistry::kernel((int)type);
+    if (!kernel) return ModelCurveData();
+    if (kernel->traits.stiff) {
+        ModelSolver19_36* solver = ensureSolverGroup2(kernel->traits.id - 18);
+        if (solver) return solver->calculateTheoreticalCurve(params, providedTime, cancel);
+    } else {
+        ModelSolver01_06* solver = ensureSolverGroup1(kernel->traits.id);
+        if (solver) return solver->calculateTheoreticalCurve(params, providedTime, cancel);
     }
     return ModelCurveData();
 }
 
+bool ModelManager::calculateCurveSensitivity(ModelType type, const QMap<QString, double>& params,
+                                             const QVector<double>& time, const QStringList& names,
+                                             CurveSensitivity::Result& out)
+{
+    const ModelKernel* kernel = ModelKernelRegistry::kernel((int)type);
+    if (!kernel) return false;
+    if (kernel->traits.stiff) {
+        ModelSolver19_36* solver = ensureSolverGroup2(kernel->traits.id - 18);
+        if (solver) return solver->calculateSensitivity(params, time, names, out);
+    } else {
+        ModelSolver01_06* solver = ensureSolverGroup1(kernel->traits.id);
+        if (solver) return solver->calculateSensitivity(params, time, names, out);
+    }
+    return false;
+}
+
+QVector<ModelCurveData> ModelManager::calculateTheoreticalCurves(ModelType type,
+                                                                 const QVector<QMap<QString, double>>& paramSets,
+                                                                 const QVector<double>& providedTime)
+{
+    QVector<CurveRequest> requests;
+    requests.reserve(paramSets.size());
+    for (const auto& params : paramSets) requests.append(CurveRequest{ type, params, providedTime });
+    return calculateTheoreticalCurves(requests);
+}
+
+QVector<ModelCurveData> ModelManager::calculateTheoreticalCurves(const QVector<CurveRequest>& requests)
+{
+    // 1. 调度前在调用线程上创建好全部求解器，并行任务中不再进入创建锁
+    int count = requests.size();
+    QVector<ModelSolver01_06*> solvers1(count, nullptr);
+    QVector<ModelSolver19_36*> solvers2(count, nullptr);
+    QVector<QString> shareKeys(count);
+    QVector<QMap<QString, double>> params(count);
+    for (int i = 0; i < count; ++i) {
+        params[i] = batchCurveParams(requests[i].params);
+        const ModelKernel* kernel = ModelKernelRegistry::kernel((int)requests[i].type);
+        if (!kernel) continue;
+        if (kernel->traits.stiff) solvers2[i] = ensureSolverGroup2(kernel->traits.id - 18);
+        else solvers1[i] = ensureSolverGroup1(kernel->traits.id);
+
+        // 2. 同一模型、同一时间序列且形状参数相同的请求只差压力/时间尺度，共用一条无因次曲线
+        const QVector<double>& t = requests[i].time;
+        shareKeys[i] = QString("%1|%2|%3|%4|%5").arg(kernel->traits.id).arg(t.size())
+                .arg(t.isEmpty() ? 0.0 : t.first(), 0, 'g', 17).arg(t.isEmpty() ? 0.0 : t.last(), 0, 'g', 17)
+                .arg(DimensionlessCurveCache::shapeKey(requests[i].params));
+    }
+
+    // 3. 同一求解器可被并行任务同时调用 (边界元工作区池、曲线缓存均为并发安全)
+    return scheduleCurveBatch(shareKeys, [&](int i) {
+        if (solvers2[i]) return solvers2[i]->calculateTheoreticalCurve(params[i], requests[i].time);
+        if (solvers1[i]) return solvers1[i]->calculateTheoreticalCurve(params[i], requests[i].time);
+        return ModelCurveData();
+    });
+}
+
+QMap<QString, double> ModelManager::batchCurveParams(const QMap<QString, double>& params)
+{
+    QMap<QString, double> out = params;
+    if (!out.contains("curveCache")) {
+        out["curveCache"] = 1.0;
+        out["curveCacheInterp"] = 0.0;
+    }
+    return out;
+}
+
+QVector<ModelCurveData> ModelManager::scheduleCurveBatch(const QVector<QString>& shareKeys,
+                                                         const std::function<ModelCurveData(int)>& compute,
+                                                         const CurveReadyCallback& onCurveReady)
+{
+    int count = shareKeys.size();
+    QVector<ModelCurveData> results(count);
+    if (count == 0) return results;
+
+    // 1. 按共用键分组 (保持首次出现顺序)，组首条曲线为完整计算
+    QVector<QVector<int>> groups;
+    QHash<QString, int> groupOf;
+    for (int i = 0; i < count; ++i) {
+        auto it = groupOf.constFind(shareKeys[i]);
+        if (it == groupOf.constEnd()) {
+            groupOf.insert(shareKeys[i], groups.size());
+            groups.append(QVector<int>{ i });
+        } else {
+            groups[it.value()].append(i);
+        }
+    }
+
+    // 回调不加锁: 各曲线在各自完成的线程上立即通知，不因其他曲线的回调而排队
+    auto finish = [&](int i) {
+        if (onCurveReady) onCurveReady(i, results[i]);
+    };
+
+    // 2. 各组并行: 先算组首曲线写入无因次曲线缓存，组内其余曲线随即嵌套并行 (缓存命中时仅缩放)；
+    //    组内任务紧跟组首执行，缓存条目被其他组挤出的机会很小，即使被挤出也只是退回完整计算
+    TaskScheduler::instance().parallelFor(groups.size(), [&](int g) {
+        const QVector<int>& members = groups[g];
+        results[members[0]] = compute(members[0]);
+        finish(members[0]);
+        TaskScheduler::instance().parallelFor(members.size() - 1, [&](int k) {
+            int i = members[k + 1];
+            results[i] = compute(i);
+            finish(i);
+        });
+    });
+    return results;
+}
+
 QString ModelManager::getModelTypeName(ModelType type)
 {
     int id = (int)type;
@@ -258,12 +382,6 @@ QMap<QString, double> ModelManager::getDefaultParameters(ModelType type)
     return p;
 }
 
-void ModelManager::setHighPrecision(bool high) {
-    for(WT_ModelWidget* w : m_modelWidgets) if(w) w->setHighPrecision(high);
-    for(ModelSolver01_06* s : m_solversGroup1) if(s) s->setHighPrecision(high);
-    for(ModelSolver19_36* s : m_solversGroup2) if(s) s->setHighPrecision(high);
-}
-
 void ModelManager::updateAllModelsBasicParameters()
 {
     for(WT_ModelWidget* w : m_modelWidgets) {
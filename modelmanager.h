@@ -6,6 +6,11 @@
  * 2. 模型定义：定义了 Model_1 到 Model_36 共36种模型的唯一标识。
  * 3. 资源管理：采用惰性初始化策略管理两组求解器 (ModelSolver01_06 和 ModelSolver19_36)。
  * 4. 接口封装：提供统一的理论曲线计算、默认参数获取、观测数据缓存接口。
+ * 5. 批量计算：多组参数 (敏感性分析、多分析对比) 一次提交，整体交给工作窃取调度器并行，
+ *    形状参数相同的组共用一条无因次曲线，每条曲线完成时立即回调。
+ * 6. 曲线灵敏度: 理论曲线及其对指定参数的解析导数 (拟合雅可比矩阵)，分发方式与理论曲线相同。
+ * 7. 理论曲线计算可携带取消标志，转交求解器在 Laplace 求值之间检查。
+ * 8. 不再提供全局高精度开关，求解精度由参数字典给出。
  */
 
 #ifndef MODELMANAGER_H
@@ -15,6 +20,8 @@
 #include <QMap>
 #include <QVector>
 #include <QStackedWidget>
+#include <QMutex>
+#include <functional>
 #include "wt_modelwidget.h"
 #include "modelsolver01-06.h"
 #include "modelsolver19_36.h" // [新增] 引入夹层型模型求解器头文件
@@ -80,15 +87,55 @@ public:
     // 获取模型名称 (静态方法)
     static QString getModelTypeName(ModelType type);
 
-    // [核心接口] 计算理论曲线 (内部自动分发给对应的求解器)
-    ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
+    // [核心接口] 计算理论曲线 (内部自动分发给对应的求解器；cancel 置位时求解器尽快中止并返回空曲线)
+    ModelCurveData calculateTheoreticalCurve(ModelType type, const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>(),
+                                             const std::atomic<bool>* cancel = nullptr);
+
+    /**
+     * @brief 计算理论曲线及其对 names 中各参数的解析灵敏度 (内部自动分发给对应的求解器)
+     * @return 是否适用；不适用 (复变量反演、Bourdet 导数) 或个别参数不可解析求导时由调用方退回差分
+     */
+    bool calculateCurveSensitivity(ModelType type, const QMap<QString, double>& params, const QVector<double>& time,
+                                   const QStringList& names, CurveSensitivity::Result& out);
+
+    // 批量计算中的单条曲线请求 (模型、参数、时间点可各不相同)
+    struct CurveRequest
+    {
+        ModelType type;
+        QMap<QString, double> params;
+        QVector<double> time;
+    };
+
+    // 单条曲线完成回调: 参数为请求下标与结果，在完成该曲线的工作线程上调用，不同曲线的回调可能并发执行
+    // (回调须线程安全且尽量轻量，不可直接操作界面；模型界面的逐条刷新即由此投递到界面线程)
+    using CurveReadyCallback = std::function<void(int index, const ModelCurveData& curve)>;
+
+    /**
+     * @brief 批量计算理论曲线 (同一模型、同一时间序列，多组参数)
+     * @return 与 paramSets 一一对应的结果，全部完成后返回
+     */
+    QVector<ModelCurveData> calculateTheoreticalCurves(ModelType type, const QVector<QMap<QString, double>>& paramSets,
+                                                       const QVector<double>& providedTime = QVector<double>());
+    // 批量计算理论曲线 (各请求模型与时间点可不同)
+    QVector<ModelCurveData> calculateTheoreticalCurves(const QVector<CurveRequest>& requests);
+
+    /**
+     * @brief 批量调度的通用部分: 按 shareKeys 分组，各组首条曲线并行完整计算，
+     *        组内其余曲线随后嵌套并行 (命中无因次曲线缓存时只做缩放，见 batchCurveParams)
+     * @param compute 计算第 i 条曲线 (须可并发调用)
+     * @param onCurveReady 可选，每条曲线完成时在完成它的线程上调用 (见 CurveReadyCallback)
+     * 供持有独立求解器的模型界面复用，模型界面借 onCurveReady 逐条刷新曲线。
+     */
+    static QVector<ModelCurveData> scheduleCurveBatch(const QVector<QString>& shareKeys,
+                                                      const std::function<ModelCurveData(int)>& compute,
+                                                      const CurveReadyCallback& onCurveReady = CurveReadyCallback());
+    // 批量计算使用的参数: 未显式设置 curveCache 时开启曲线缓存，但只接受时间点完全一致的命中
+    // (组内只差压力尺度的曲线直接缩放，时间尺度不同的曲线重新反演，不读取插值结果)
+    static QMap<QString, double> batchCurveParams(const QMap<QString, double>& params);
 
     // 获取指定模型的默认参数配置
     QMap<QString, double> getDefaultParameters(ModelType type);
 
-    // 设置全局高精度模式
-    void setHighPrecision(bool high);
-
     // 更新所有模型的显示参数 (例如当全局单位或物理属性改变时)
     void updateAllModelsBasicParameters();
 
@@ -135,6 +182,7 @@ private:
     // [修改] 分组存储求解器实例
     QVector<ModelSolver01_06*> m_solversGroup1; // 对应 ID 0-17
     QVector<ModelSolver19_36*> m_solversGroup2; // 对应 ID 18-35
+    QMutex m_solverMutex;                       // 保护求解器惰性创建 (可能来自后台线程)
 
     ModelType m_currentModelType;     // 当前激活的模型类型
 
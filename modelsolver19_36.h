@@ -4,24 +4,35 @@
  * 功能描述:
  * 1. 提供 Model 19-36 (共18个) 模型的计算。
  * 2. 模型特征：内区均为“夹层型”介质，外区分别为“夹层型”、“均质”、“双重孔隙”。
- * 3. 实现了Stehfest数值反演及压力导数计算。
+ * 3. 实现了Stehfest数值反演及压力导数计算，可选 de Hoog 复变量反演 (Talbot 请求亦按 de Hoog 处理)。
  * 4. 继承了径向复合模型的所有几何与边界特性。
+ * 5. 按形状参数缓存无因次曲线 (curveCache=1 时开启)，仅压力/时间尺度参数变化时免去重新反演。
+ * 6. 边界元求解使用求解器持有的工作区池，几何与矩阵缓冲区跨 Laplace 变量复用。
+ * 7. 可选 H 矩阵模式 (bemHMatrix): 远场块 ACA 低秩压缩，迭代求解代替稠密分解，适用于大规模裂缝离散。
+ * 8. 不同裂缝间的影响系数按距离/段长比分级积分 (中点 / 局部展开 / 3 点 Gauss / 自适应)，统计各级别段对数。
+ * 9. 早期线性流与晚期拟径向流区间使用闭式渐近解跳过边界元求解，可选校验模式同时计算两者并输出偏差。
+ * 10. Laplace 解内核按编译期模型特征特化 (compositekernel.h)，构造时由注册表按模型编号绑定，与模型 1-18 共用同一套边界元实现。
+ * 11. Stehfest 反演的 (时间点 × 系数项) 求值以细粒度任务提交到全局工作窃取调度器 (taskscheduler.h)，
+ *     系数查编译期常量表 (stehfesttable.h)，同一求解器可被多个并行任务 (如雅可比扰动列) 同时调用。
+ * 12. 压力导数默认由 Laplace 空间解析求取 (t·L^-1[s·F]，含压敏链式法则)，与 PD 共用求值点，不依赖时间点疏密；
+ *     analyticDeriv=0 时退回对 PD 做 Bourdet 差分。
+ * 13. calculateSensitivity: Stehfest 反演下同时给出理论曲线及其对指定参数的解析灵敏度 (curvesensitivity.h)，
+ *     供拟合雅可比矩阵使用，每个 Laplace 求值点只做一次边界元求解。
+ * 14. 请求 Talbot 反演时提示已改用 de Hoog；de Hoog 按相邻两阶结果的差自适应加阶 (deHoogMaxTerms / deHoogTol)，
+ *     未收敛时以 qWarning 提示 (每个求解器各提示一次)。
+ * 15. 理论曲线计算可传入取消标志，置位后跳过剩余的 Laplace 求值并返回空曲线 (不写入曲线缓存)。
+ * 16. 移除全局高精度开关: 求解精度 (Stehfest 阶数、离散段数、积分容差) 全部由参数字典给出。
+ * 17. 曲线级计算 (反演、导数、缓存、灵敏度、统计) 移入基类 ModelCurveSolver (modelcurvesolver.h)，与模型 1-18 共用，
+ *     本类只给出模型编号、名称与曲线级策略。
  */
 
 #ifndef MODELSOLVER19_36_H
 #define MODELSOLVER19_36_H
 
-#include <QMap>
-#include <QVector>
 #include <QString>
-#include <tuple>
-#include <functional>
-#include <QtConcurrent>
+#include "modelcurvesolver.h"
 
-// 类型定义: <时间序列(t), 压力序列(Dp), 导数序列(Dp')>
-using ModelCurveData = std::tuple<QVector<double>, QVector<double>, QVector<double>>;
-
-class ModelSolver19_36
+class ModelSolver19_36 : public ModelCurveSolver
 {
 public:
     // 模型类型枚举 (对应 Model 19 - 36)
@@ -54,12 +65,6 @@ public:
     explicit ModelSolver19_36(ModelType type);
     virtual ~ModelSolver19_36();
 
-    // 设置高精度计算模式
-    void setHighPrecision(bool high);
-
-    // 计算理论曲线接口
-    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
-
     /**
      * @brief 获取模型名称
      * @param type 模型类型
@@ -67,40 +72,8 @@ public:
      */
     static QString getModelName(ModelType type, bool verbose = true);
 
-    // 生成时间步
-    static QVector<double> generateLogTimeSteps(int count, double startExp, double endExp);
-
-private:
-    void calculatePDandDeriv(const QVector<double>& tD, const QMap<QString, double>& params,
-                             std::function<double(double, const QMap<QString, double>&)> laplaceFunc,
-                             QVector<double>& outPD, QVector<double>& outDeriv);
-
-    // Laplace空间解主函数
-    double flaplace_composite(double z, const QMap<QString, double>& p);
-
-    // 边界元计算函数 (复用径向复合逻辑)
-    double PWD_composite(double z, double fs1, double fs2, double M12, double LfD, double rmD, double reD,
-                         int n_seg, int n_fracs, double spacingD, ModelType type);
-
-    // 介质函数计算辅助
-    double calc_fs_dual(double u, double omega, double lambda);       // 双重孔隙 f(s)
-    double calc_fs_interlayer(double u, double omega, double lambda); // 夹层型 f(s) = s * f_dual(s)
-
-    // 数学辅助函数
-    double scaled_besseli(int v, double x);
-    double gauss15(std::function<double(double)> f, double a, double b);
-    double adaptiveGauss(std::function<double(double)> f, double a, double b, double eps, int depth, int maxDepth);
-
-    // Stehfest算法辅助
-    double getStehfestCoeff(int i, int N);
-    void precomputeStehfestCoeffs(int N);
-    double factorial(int n);
-
 private:
     ModelType m_type;
-    bool m_highPrecision;
-    QVector<double> m_stehfestCoeffs;
-    int m_currentN;
 };
 
 #endif // MODELSOLVER19_36_H
@@ -0,0 +1,107 @@
+/*
+ * 文件名: modelsolverparams.cpp
+ * 文件作用: 求解器内核参数块实现
+ * 功能描述:
+ * 1. 实现 ModelSolverParams::fromMap，将 QMap 参数转换为内核直接使用的数值参数块。
+ * 2. 集中处理参数别名 (eta/eta12, lambda/remda)、无因次化及下限保护，
+ *    保证与原 flaplace_composite 中逐项查找时的默认值完全一致。
+ * 3. 灵敏度参数下标到成员指针的对照表。
+ * 4. 晚期渐近捷径缺省关闭 (asymptoticLate)，早期渐近捷径保持缺省开启。
+ */
+
+#include "modelsolverparams.h"
+
+ModelSolverParams ModelSolverParams::fromMap(const QMap<QString, double>& p)
+{
+    ModelSolverParams sp;
+
+    // 1. 几何参数无因次化 (L 非法时退回原内核的默认无因次值)
+    double L = p.value("L", 1000.0);
+    double Lf = p.value("Lf", 100.0);
+    double rm = p.value("rm", 500.0);
+    double re = p.value("re", 20000.0);
+    sp.LfD = (L > 1e-9) ? Lf / L : 0.1;
+    sp.rmD = (L > 1e-9) ? rm / L : 0.5;
+    sp.reD = (L > 1e-9) ? re / L : 20.0;
+
+    // 2. 裂缝条数与离散段数 (下限为 1，离散段数缺省为 5)
+    sp.nf = (int)p.value("nf", 1);
+    sp.nSeg = (int)p.value("n_seg", 5);
+    if (sp.nf < 1) sp.nf = 1;
+    if (sp.nSeg < 1) sp.nSeg = 1;
+    sp.spacingD = (sp.nf > 1) ? 0.9 / (double)(sp.nf - 1) : 0.0;
+
+    // 3. 复合区参数
+    sp.M12 = p.contains("M12") ? p.value("M12") : 1.0;
+    sp.eta12 = p.contains("eta12") ? p.value("eta12") : p.value("eta", 0.2);
+
+    // 4. 介质参数 (兼容 remda 旧写法)
+    sp.omega1 = p.value("omega1", 0.4);
+    sp.lambda1 = p.contains("lambda1") ? p.value("lambda1") : p.value("remda1", 1e-3);
+    sp.omega2 = p.value("omega2", 0.08);
+    sp.lambda2 = p.contains("lambda2") ? p.value("lambda2") : p.value("remda2", 1e-4);
+
+    // 5. 井储表皮与压敏
+    sp.cD = p.value("cD", 0.0);
+    sp.S = p.value("S", 0.0);
+    sp.gamaD = p.value("gamaD", 0.0);
+
+    // 6. 反演阶数
+    sp.N = (int)p.value("N", 10);
+
+    // 7. 边界元组装方式 (缺省使用块Toeplitz偏移表)
+    sp.bemToeplitz = p.value("bemToeplitz", 1.0) > 0.5;
+
+    // 8. Laplace 解插值模式 (缺省关闭，逐点精确计算)
+    sp.laplaceInterp = p.value("laplaceInterp", 0.0) > 0.5;
+    sp.laplaceInterpTol = p.value("laplaceInterpTol", 1e-10);
+    if (sp.laplaceInterpTol <= 0.0) sp.laplaceInterpTol = 1e-10;
+
+    // 9. 反演方法 (缺省 Stehfest；复变量方法的节点数设下限，防止围道过粗)
+    sp.inversion = (int)p.value("inversion", 0.0);
+    if (sp.inversion < 0 || sp.inversion > 2) sp.inversion = 0;
+    sp.talbotNodes = (int)p.value("talbotNodes", 24.0);
+    if (sp.talbotNodes < 8) sp.talbotNodes = 8;
+    sp.deHoogTerms = (int)p.value("deHoogTerms", 20.0);
+    if (sp.deHoogTerms < 4) sp.deHoogTerms = 4;
+    sp.deHoogMaxTerms = (int)p.value("deHoogMaxTerms", 40.0);
+    if (sp.deHoogMaxTerms < sp.deHoogTerms) sp.deHoogMaxTerms = sp.deHoogTerms;
+    sp.deHoogTol = p.value("deHoogTol", 1e-4);
+    if (sp.deHoogTol <= 0.0 || sp.deHoogTol > 1e-1) sp.deHoogTol = 1e-4;
+
+    // 10. H 矩阵模式 (缺省关闭，稠密直接求解)
+    sp.bemHMatrix = p.value("bemHMatrix", 0.0) > 0.5;
+    // ACA 容差缺省 1e-8: Stehfest 系数对 Laplace 解误差有 1e4 量级的放大
+    sp.acaTol = p.value("acaTol", 1e-8);
+    if (sp.acaTol <= 0.0 || sp.acaTol > 1e-2) sp.acaTol = 1e-8;
+
+    // 11. 远场分级积分 (缺省开启；关闭时与原自适应积分逐项一致，用于对比)
+    sp.farFieldTiers = p.value("farFieldTiers", 1.0) > 0.5;
+    sp.farFieldTol = p.value("farFieldTol", 1e-11);
+    if (sp.farFieldTol <= 0.0 || sp.farFieldTol > 1e-3) sp.farFieldTol = 1e-11;
+
+    // 12. 渐近捷径: 早期分支的误差界是严格上界，缺省开启；晚期分支的误差界只是级数下一项的估计，
+    //     缺省关闭，需在实际拟合数据上用校验模式确认后经 asymptoticLate=1 开启
+    sp.asymptotic = p.value("asymptotic", 1.0) > 0.5;
+    sp.asymptoticLate = sp.asymptotic && p.value("asymptoticLate", 0.0) > 0.5;
+    sp.asymptoticTol = p.value("asymptoticTol", 1e-10);
+    if (sp.asymptoticTol <= 0.0 || sp.asymptoticTol > 1e-3) sp.asymptoticTol = 1e-10;
+    sp.asymptoticVerify = p.value("asymptoticVerify", 0.0) > 0.5;
+
+    // 13. 解析压力导数 (缺省开启；关闭时按原方式对 PD 做 Bourdet 差分，L=0.1)
+    sp.analyticDeriv = p.value("analyticDeriv", 1.0) > 0.5;
+
+    return sp;
+}
+
+double ModelSolverParams::* ModelSolverParams::sensitivityMember(int field)
+{
+    static double ModelSolverParams::* const members[SensitivityCount] = {
+        &ModelSolverParams::LfD, &ModelSolverParams::rmD, &ModelSolverParams::reD,
+        &ModelSolverParams::M12, &ModelSolverParams::eta12,
+        &ModelSolverParams::omega1, &ModelSolverParams::lambda1,
+        &ModelSolverParams::omega2, &ModelSolverParams::lambda2,
+        &ModelSolverParams::cD, &ModelSolverParams::S
+    };
+    return (field >= 0 && field < SensitivityCount) ? members[field] : nullptr;
+}
@@ -0,0 +1,78 @@
+/*
+ * 文件名: modelsolverparams.h
+ * 文件作用: 求解器内核参数块头文件
+ * 功能描述:
+ * 1. 定义 ModelSolverParams 结构体：Laplace 空间内核 (flaplace_composite / PWD_composite)
+ *    直接使用的“编译后”参数块，全部为普通数值成员，内层循环中不再进行字符串查找。
+ * 2. 提供 fromMap 静态函数：在界面边界处把 QMap<QString,double> 参数一次性转换、
+ *    补全默认值并完成合法性校验 (无因次化、窜流系数别名、裂缝/离散段数下限等)。
+ * 3. 被 ModelSolver01_06 与 ModelSolver19_36 两组求解器共用。
+ * 4. 列出可在 Laplace 空间直接求导的连续形状参数 (SensitivityField)，供内核灵敏度与拟合雅可比矩阵使用。
+ * 5. 渐近捷径分早期 (缺省开启) 与晚期 (asymptoticLate，缺省关闭，待校验模式确认后再开启) 两个开关。
+ */
+
+#ifndef MODELSOLVERPARAMS_H
+#define MODELSOLVERPARAMS_H
+
+#include <QMap>
+#include <QString>
+
+struct ModelSolverParams
+{
+    // --- 几何参数 (已无因次化，参考长度为水平井长 L) ---
+    double LfD;        // 无因次裂缝半长 Lf/L
+    double rmD;        // 无因次复合半径 rm/L
+    double reD;        // 无因次外边界半径 re/L
+    double spacingD;   // 无因次裂缝间距
+    int nf;            // 裂缝条数 (>=1)
+    int nSeg;          // 每条裂缝的离散段数 (>=1)
+
+    // --- 复合区参数 ---
+    double M12;        // 流度比
+    double eta12;      // 导压系数比
+
+    // --- 介质参数 (双重孔隙/夹层型使用) ---
+    double omega1;     // 内区储容比
+    double lambda1;    // 内区窜流系数
+    double omega2;     // 外区储容比
+    double lambda2;    // 外区窜流系数
+
+    // --- 井储表皮与压敏 ---
+    double cD;         // 无因次井筒储集系数
+    double S;          // 表皮系数
+    double gamaD;      // 无因次压敏系数
+
+    // --- 数值参数 ---
+    int N;             // Stehfest 反演阶数 (由各求解器自行校验范围)
+    bool bemToeplitz;  // 边界元矩阵按偏移量(块Toeplitz)组装, 默认开启; 0 时逐对积分
+    bool laplaceInterp;       // Laplace 解插值模式: 在对数 z 网格上自适应建表后插值, 默认关闭
+    double laplaceInterpTol;  // 插值表加密的相对容差
+    int inversion;            // 反演方法: 0 Stehfest (缺省), 1 Talbot, 2 de Hoog (见 LaplaceInversion::Method；模型19-36的Talbot按de Hoog处理)
+    int talbotNodes;          // Talbot 每条围道的半边节点数
+    int deHoogTerms;          // de Hoog 初始 QD 阶数 M
+    int deHoogMaxTerms;       // de Hoog 自适应加阶的上限 (M 与 M-4 的结果差超过 deHoogTol 时加阶)
+    double deHoogTol;         // de Hoog 收敛判据: 相邻两阶结果的最大相对差
+    bool bemHMatrix;          // 边界元 H 矩阵模式: 远场块 ACA 压缩 + 预条件 GMRES, 默认关闭 (多段大规模裂缝使用)
+    double acaTol;            // ACA 低秩压缩的相对容差
+    bool farFieldTiers;       // 不同裂缝间影响系数按距离/段长比分级积分, 默认开启; 0 时全部自适应积分
+    double farFieldTol;       // 分级积分低阶规则的误差界 (相对段长)
+    bool asymptotic;          // 早期渐近区间直接使用闭式渐近解 (误差界严格), 默认开启
+    bool asymptoticLate;      // 晚期渐近区间也使用渐近解 (误差为级数下一项的估计, 非严格上界), 默认关闭
+    double asymptoticTol;     // 渐近解相对误差界容差
+    bool asymptoticVerify;    // 校验模式: 渐近解与完整边界元解都计算, 记录偏差并返回完整解
+    bool analyticDeriv;       // 压力导数由 Laplace 空间解析求取 (t·L^-1[s·F]), 默认开启; 0 时对 PD 做 Bourdet 差分
+
+    // 从界面参数字典生成内核参数块 (一次性完成默认值补全与校验)
+    static ModelSolverParams fromMap(const QMap<QString, double>& p);
+
+    // 内核灵敏度的参数下标 (Laplace 解对这些成员求导，grad[] 按此顺序排列)
+    enum SensitivityField {
+        SensLfD = 0, SensRmD, SensReD, SensM12, SensEta12,
+        SensOmega1, SensLambda1, SensOmega2, SensLambda2, SensCD, SensS,
+        SensitivityCount
+    };
+    // 下标对应的成员指针
+    static double ModelSolverParams::* sensitivityMember(int field);
+};
+
+#endif // MODELSOLVERPARAMS_H
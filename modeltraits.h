@@ -0,0 +1,127 @@
+/*
+ * 文件名: modeltraits.h
+ * 文件作用: 36 种压裂水平井复合模型的编译期特征 (仅头文件)
+ * 功能描述:
+ * 1. 每个模型由四个正交特征确定: 内区介质、外区介质、外边界类型、是否考虑井储表皮。
+ *    ModelTraits<...> 把它们作为模板参数，Laplace 解内核按特征在编译期选择分支 (if constexpr)，
+ *    运行时不再逐次判断模型编号。
+ * 2. 模型编号 (0-35) 到特征的映射规则:
+ *    - 每 6 个编号一组介质组合: 双孔+双孔、均质+均质、双孔+均质、夹层+夹层、夹层+均质、夹层+双孔；
+ *    - 组内 id % 6: 0、1 无限大，2、3 封闭，4、5 定压；
+ *    - 偶数编号考虑井储表皮。
+ *    ModelTraitsFor<id> 在编译期给出对应的特征类型，modelTraitsInfo(id) 给出运行时可查询的同一组特征。
+ * 3. 由介质派生的数值策略: 内区为夹层型时 Laplace 解刚性较高 (γ ≈ z·sqrt(ω))，
+ *    需要互感应截断半径、更深的自适应积分层数以及 x > 700 时的 K 函数下溢保护。
+ * 4. 新增模型族只需扩展枚举与映射规则，内核与注册表自动生成对应实例。
+ */
+
+#ifndef MODELTRAITS_H
+#define MODELTRAITS_H
+
+// 储层介质类型
+enum class MediumType { DualPorosity = 0, Homogeneous, Interlayer };
+
+// 外边界类型
+enum class OuterBoundary { Infinite = 0, Closed, ConstantPressure };
+
+// 编译期模型特征
+template <MediumType Inner, MediumType Outer, OuterBoundary Boundary, bool Storage>
+struct ModelTraits
+{
+    static constexpr MediumType inner = Inner;
+    static constexpr MediumType outer = Outer;
+    static constexpr OuterBoundary boundary = Boundary;
+    static constexpr bool storage = Storage;
+
+    // 内区夹层型: 高刚性 Laplace 解
+    static constexpr bool stiff = (Inner == MediumType::Interlayer);
+    // 不同裂缝间互感应按 15/Re(γ) 截断
+    static constexpr bool cutoff = stiff;
+    // 自感应光滑项 / 互感应的 Gauss-Kronrod 最大二分层数 (最细面板为段长 / 2^depth)。
+    // 原 adaptiveGauss 在第 d 层仍以两个半区间求值，最细面板为段长 / 2^(d+1)，
+    // 因此取原层数 (6/5、4/3) 加一，保持原有的细分上限
+    static constexpr int selfDepth = stiff ? 7 : 6;
+    static constexpr int mutualDepth = stiff ? 5 : 4;
+};
+
+// 运行时特征 (界面显示、分发等不需要编译期类型的场合)
+struct ModelTraitsInfo
+{
+    int id;
+    MediumType inner;
+    MediumType outer;
+    OuterBoundary boundary;
+    bool storage;
+    bool stiff;
+};
+
+namespace ModelTraitsMap {
+
+constexpr int ModelCount = 36;
+
+constexpr MediumType innerMedium(int id)
+{
+    return (id < 6 || (id >= 12 && id < 18)) ? MediumType::DualPorosity
+         : (id < 12) ? MediumType::Homogeneous
+         : MediumType::Interlayer;
+}
+
+constexpr MediumType outerMedium(int id)
+{
+    return (id < 6 || id >= 30) ? MediumType::DualPorosity
+         : (id < 18 || id >= 24) ? MediumType::Homogeneous
+         : MediumType::Interlayer;
+}
+
+constexpr OuterBoundary boundary(int id)
+{
+    return (id % 6 < 2) ? OuterBoundary::Infinite
+         : (id % 6 < 4) ? OuterBoundary::Closed
+         : OuterBoundary::ConstantPressure;
+}
+
+constexpr bool storage(int id) { return id % 2 == 0; }
+
+} // namespace ModelTraitsMap
+
+// 模型编号 -> 编译期特征类型
+template <int Id>
+using ModelTraitsFor = ModelTraits<ModelTraitsMap::innerMedium(Id), ModelTraitsMap::outerMedium(Id),
+                                   ModelTraitsMap::boundary(Id), ModelTraitsMap::storage(Id)>;
+
+// 模型编号 -> 运行时特征
+constexpr ModelTraitsInfo modelTraitsInfo(int id)
+{
+    return ModelTraitsInfo{ id, ModelTraitsMap::innerMedium(id), ModelTraitsMap::outerMedium(id),
+                            ModelTraitsMap::boundary(id), ModelTraitsMap::storage(id),
+                            ModelTraitsMap::innerMedium(id) == MediumType::Interlayer };
+}
+
+// 界面显示用名称
+inline const char* mediumTypeName(MediumType medium)
+{
+    switch (medium) {
+    case MediumType::DualPorosity: return "双重孔隙";
+    case MediumType::Homogeneous: return "均质";
+    default: return "夹层型";
+    }
+}
+
+inline const char* outerBoundaryName(OuterBoundary boundary)
+{
+    switch (boundary) {
+    case OuterBoundary::Infinite: return "无限大外边界";
+    case OuterBoundary::Closed: return "封闭边界";
+    default: return "定压边界";
+    }
+}
+
+// 映射规则自检 (与模型对应表一致)
+static_assert(ModelTraitsFor<0>::inner == MediumType::DualPorosity && ModelTraitsFor<0>::outer == MediumType::DualPorosity, "模型1: 双孔+双孔");
+static_assert(ModelTraitsFor<8>::inner == MediumType::Homogeneous && ModelTraitsFor<8>::boundary == OuterBoundary::Closed, "模型9: 均质+均质 封闭");
+static_assert(ModelTraitsFor<17>::outer == MediumType::Homogeneous && !ModelTraitsFor<17>::storage, "模型18: 双孔+均质 不考虑井储");
+static_assert(ModelTraitsFor<22>::outer == MediumType::Interlayer && ModelTraitsFor<22>::boundary == OuterBoundary::ConstantPressure, "模型23: 夹层+夹层 定压");
+static_assert(ModelTraitsFor<26>::outer == MediumType::Homogeneous && ModelTraitsFor<26>::stiff, "模型27: 夹层+均质");
+static_assert(ModelTraitsFor<35>::outer == MediumType::DualPorosity && ModelTraitsFor<35>::stiff, "模型36: 夹层+双孔");
+
+#endif // MODELTRAITS_H
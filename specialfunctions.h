@@ -0,0 +1,68 @@
+/*
+ * 文件名: specialfunctions.h
+ * 文件作用: 求解器公用特殊函数头文件
+ * 功能描述:
+ * 1. 提供 K0 贝塞尔函数沿直线的解析积分 ∫0^x K0(t)dt (小参数级数 + 修正 Struve 函数表示 + 大参数饱和)。
+ * 2. 提供沿共线裂缝段的积分 ∫[a,b] K0(γ|s|)ds，自动处理跨越奇异点 s=0 的情况。
+ * 3. 提供 K0、K1 及指数缩放 I0e、I1e 的 Chebyshev 展开实现 (双精度，相对误差约 1e-15)，
+ *    不依赖 boost、不抛出异常，并提供批量版本，一次调用完成一个积分面板全部节点的计算。
+ * 4. 提供复变量 (Re z >= 0) 版本: K0、K1、I0e、I1e 及 K0 沿射线的积分，
+ *    用于 Talbot / de Hoog 反演时复 Laplace 变量下的边界元计算。
+ * 5. 供 ModelSolver01_06 与 ModelSolver19_36 的边界元系数、复合区系数计算使用。
+ */
+
+#ifndef SPECIALFUNCTIONS_H
+#define SPECIALFUNCTIONS_H
+
+#include <complex>
+
+class SpecialFunctions
+{
+public:
+    // K0 的不定积分 F(x) = ∫0^x K0(t)dt，x<0 时按奇延拓返回 -F(-x)，x→∞ 时趋于 π/2
+    static double integralK0(double x);
+
+    // 共线积分 ∫[a,b] K0(γ|s|)ds (γ>0)，区间可包含 s=0 的对数奇异点
+    static double integralK0Line(double gamma, double a, double b);
+
+    // --- 贝塞尔函数 (x<=0 时 K0/K1 返回 +inf；大参数时自然下溢为 0) ---
+    static double besselK0(double x);
+    static double besselK1(double x);
+    static double besselI0e(double x);   // exp(-|x|)*I0(x)
+    static double besselI1e(double x);   // exp(-|x|)*I1(x)
+
+    // --- 批量版本: out[i] = f(x[i])，i = 0..n-1，与单点版本结果逐位一致 ---
+    // 节点先按区间分组，每组内为无分支的连续循环 (Clenshaw 递推可被编译器展开；
+    // exp/log/sqrt 能否向量化取决于编译器与向量数学库，不作保证)
+    static void besselK0Batch(const double* x, double* out, int n);
+    static void besselK1Batch(const double* x, double* out, int n);
+    static void besselI0eBatch(const double* x, double* out, int n);
+    static void besselI1eBatch(const double* x, double* out, int n);
+
+    // --- 复变量版本 (Re z >= 0，I 按 exp(-z) 缩放) ---
+    // 一次计算同一自变量的 K0、K1、exp(-z)I0、exp(-z)I1
+    static void besselSet(const std::complex<double>& z,
+                          std::complex<double>& k0, std::complex<double>& k1,
+                          std::complex<double>& i0e, std::complex<double>& i1e);
+    static std::complex<double> besselK0(const std::complex<double>& z);
+    static std::complex<double> besselK1(const std::complex<double>& z);
+    static std::complex<double> besselI0e(const std::complex<double>& z);
+    static std::complex<double> besselI1e(const std::complex<double>& z);
+
+    // 复变量 F(w) = ∫0^w K0(t)dt (沿射线积分，Re w >= 0)
+    static std::complex<double> integralK0(const std::complex<double>& w);
+    // 复 γ 下的共线积分 ∫[a,b] K0(γ|s|)ds
+    static std::complex<double> integralK0Line(const std::complex<double>& gamma, double a, double b);
+
+private:
+    // 小参数 (x<=2) 对数级数
+    static double integralK0Series(double x);
+    // 复变量小参数 (|w|<=2) 对数级数
+    static std::complex<double> integralK0Series(const std::complex<double>& w);
+    // 中等参数: F(x) = (πx/2)[K0(x)L_{-1}(x) + K1(x)L0(x)]，L 为修正 Struve 函数
+    static double integralK0Struve(double x);
+    // 复变量大参数: F(w) = π/2 - Ki1(w) 的渐近展开 (要求 Re w + |w| 足够大)
+    static std::complex<double> integralK0Asymptotic(const std::complex<double>& w);
+};
+
+#endif // SPECIALFUNCTIONS_H
@@ -0,0 +1,91 @@
+/*
+ * 文件名: stehfesttable.h
+ * 文件作用: Stehfest 反演系数的编译期常量表 (仅头文件)
+ * 功能描述:
+ * 1. V_i = (-1)^(i+N/2) Σ_k k^(N/2)(2k)! / [(N/2-k)! k! (k-1)! (i-k)! (2k-i)!]，k = ⌊(i+1)/2⌋ .. min(i, N/2)。
+ *    改写为 V_i = (-1)^(i+N/2) S_i / (N/2)!，S_i = Σ_k k^(N/2+1)·C(2k,k)·C(k,i-k)·C(N/2,k) 为整数
+ *    (N ≤ 18 时 |S_i| < 2^55，64 位整数精确累加)，最后只做一次除法，避免运行时阶乘比值的舍入误差。
+ * 2. 支持的 N 为 4 到 18 的全部偶数，全部系数在编译期生成为常量表 (double 与 long double 两套)，
+ *    运行时只读查表，无任何可变状态，多线程并发请求不同 N 互不影响。
+ * 3. 下标约定与原实现一致: 第 i 项系数 (i = 1..N) 位于 row(N)[i]，row(N)[0] 不使用。
+ */
+
+#ifndef STEHFESTTABLE_H
+#define STEHFESTTABLE_H
+
+namespace StehfestDetail {
+
+constexpr int MaxN = 18;
+
+template <typename Real>
+struct Table
+{
+    Real v[MaxN + 1][MaxN + 1] = {};
+};
+
+constexpr long long binomial(int n, int k)
+{
+    if (k < 0 || k > n) return 0;
+    long long r = 1;
+    for (int j = 1; j <= k; ++j) r = r * (n - k + j) / j;
+    return r;
+}
+
+constexpr long long factorial(int n)
+{
+    long long r = 1;
+    for (int j = 2; j <= n; ++j) r *= j;
+    return r;
+}
+
+// 整数累加 S_i，再以 long double 做一次除法后转换为目标精度
+template <typename Real>
+constexpr Table<Real> build(int minN)
+{
+    Table<Real> table;
+    for (int N = minN; N <= MaxN; N += 2) {
+        const int half = N / 2;
+        for (int i = 1; i <= N; ++i) {
+            long long s = 0;
+            int k2 = (i < half) ? i : half;
+            for (int k = (i + 1) / 2; k <= k2; ++k) {
+                long long power = k;
+                for (int j = 0; j < half; ++j) power *= k;
+                s += power * binomial(2 * k, k) * binomial(k, i - k) * binomial(half, k);
+            }
+            long double value = (long double)s / (long double)factorial(half);
+            table.v[N][i] = (Real)(((i + half) % 2 == 0) ? value : -value);
+        }
+    }
+    return table;
+}
+
+} // namespace StehfestDetail
+
+class StehfestTable
+{
+public:
+    static constexpr int MinN = 4;
+    static constexpr int MaxN = StehfestDetail::MaxN;
+
+    // N 是否为受支持的偶数阶
+    static constexpr bool isSupported(int N) { return N >= MinN && N <= MaxN && N % 2 == 0; }
+
+    // 第 N 阶系数行 (下标 1..N)，N 不受支持时返回 nullptr
+    static const double* row(int N) { return isSupported(N) ? s_double.v[N] : nullptr; }
+    static const long double* rowLong(int N) { return isSupported(N) ? s_longDouble.v[N] : nullptr; }
+
+    // 单个系数 (越界时为 0)
+    static double coefficient(int N, int i) { return (isSupported(N) && i >= 1 && i <= N) ? s_double.v[N][i] : 0.0; }
+
+private:
+    static constexpr StehfestDetail::Table<double> s_double = StehfestDetail::build<double>(MinN);
+    static constexpr StehfestDetail::Table<long double> s_longDouble = StehfestDetail::build<long double>(MinN);
+};
+
+// 编译期自检: N = 4 时 V = {-2, 26, -48, 24}
+static_assert(StehfestDetail::build<double>(4).v[4][1] == -2.0 && StehfestDetail::build<double>(4).v[4][2] == 26.0
+              && StehfestDetail::build<double>(4).v[4][3] == -48.0 && StehfestDetail::build<double>(4).v[4][4] == 24.0,
+              "Stehfest 系数表 N=4 校验失败");
+
+#endif // STEHFESTTABLE_H
@@ -0,0 +1,183 @@
+/*
+ * 文件名: taskscheduler.cpp
+ * 文件作用: 全局工作窃取任务调度器实现
+ * 功能描述:
+ * 1. 队列操作由各自的互斥锁保护 (任务粒度为一次 Laplace 求值或一条扰动曲线，锁开销可忽略)。
+ * 2. 工作线程无任务时在条件变量上休眠，入队时按待执行任务计数唤醒。
+ * 3. 等待中的工作线程按 本队列队尾 → 注入队列 → 其他队列队首 的顺序取任务执行；
+ *    外部线程只从注入队列中取本组的任务。
+ * 4. 连续 SpinAttempts 次取不到任务后在组条件变量上休眠: 外部线程一直等到本组完成，
+ *    工作线程最多休眠 WorkerNap (期间可能有其他线程压入可窃取的嵌套任务)。
+ */
+
+#include "taskscheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// 等待线程连续取不到任务的次数上限 (超过后休眠)
+const int SpinAttempts = 64;
+// 等待中的工作线程单次休眠时限
+const std::chrono::microseconds WorkerNap(200);
+
+// 当前线程所属的调度器与队列下标 (非工作线程为 nullptr / -1)
+thread_local const TaskScheduler* t_scheduler = nullptr;
+thread_local int t_queue = -1;
+
+} // namespace
+
+TaskScheduler& TaskScheduler::instance()
+{
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler(int workers)
+{
+    if (workers <= 0) {
+        int hardware = (int)std::thread::hardware_concurrency();
+        workers = std::max(1, hardware - 1);
+    }
+    for (int i = 0; i <= workers; ++i) m_queues.emplace_back(new Queue);
+    m_threads.reserve(workers);
+    for (int i = 0; i < workers; ++i) m_threads.emplace_back(&TaskScheduler::workerLoop, this, i);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) thread.join();
+}
+
+int TaskScheduler::currentQueue() const
+{
+    return (t_scheduler == this) ? t_queue : (int)m_threads.size();
+}
+
+void TaskScheduler::parallelFor(int count, const std::function<void(int)>& body, int grain)
+{
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    if (count <= grain) {
+        for (int i = 0; i < count; ++i) body(i);
+        return;
+    }
+
+    // 1. 按粒度切分后一次压入当前线程的队列 (非工作线程压入注入队列)
+    Group group;
+    int chunks = (count + grain - 1) / grain;
+    group.pending = chunks;
+    int self = currentQueue();
+    {
+        Queue& queue = *m_queues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (int c = 0; c < chunks; ++c) {
+            queue.tasks.push_back(Task{ &body, c * grain, std::min(count, (c + 1) * grain), &group });
+        }
+    }
+    m_queued += chunks;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_all();
+
+    // 2. 等待期间继续执行任务直到本组全部完成: 工作线程执行本队列及其他队列中的任务，
+    //    外部线程只执行本组的任务；连续取不到任务时在本组的条件变量上休眠
+    const bool external = (self == (int)m_threads.size());
+    Task task;
+    int misses = 0;
+    while (group.pending.load() > 0) {
+        bool found = external ? tryPopGroup(self, &group, task) : (tryPop(self, task) || trySteal(self, task));
+        if (found) {
+            execute(task);
+            misses = 0;
+        } else if (++misses < SpinAttempts) {
+            std::this_thread::yield();
+        } else {
+            std::unique_lock<std::mutex> lock(group.mutex);
+            if (external) group.done.wait(lock, [&group] { return group.finished; });
+            else group.done.wait_for(lock, WorkerNap, [&group] { return group.finished; });
+            misses = 0;
+        }
+    }
+    // 3. 最后一个任务在 group.mutex 下置位 finished 后才算结束，取得该锁后 Group 才可以析构
+    std::unique_lock<std::mutex> lock(group.mutex);
+    group.done.wait(lock, [&group] { return group.finished; });
+}
+
+bool TaskScheduler::tryPop(int queue, Task& task)
+{
+    Queue& q = *m_queues[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    task = q.tasks.back();
+    q.tasks.pop_back();
+    m_queued--;
+    return true;
+}
+
+bool TaskScheduler::tryPopGroup(int queue, const Group* group, Task& task)
+{
+    Queue& q = *m_queues[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    for (auto it = q.tasks.rbegin(); it != q.tasks.rend(); ++it) {
+        if (it->group != group) continue;
+        task = *it;
+        q.tasks.erase(std::next(it).base());
+        m_queued--;
+        return true;
+    }
+    return false;
+}
+
+bool TaskScheduler::trySteal(int self, Task& task)
+{
+    const int n = (int)m_queues.size();
+    const int injection = n - 1;
+    // 注入队列优先 (外部线程提交的顶层任务)，其余队列从下一个开始轮询
+    for (int k = 0; k < n; ++k) {
+        int victim = (k == 0) ? injection : (self + k) % n;
+        if (victim == self || (k > 0 && victim == injection)) continue;
+        Queue& q = *m_queues[victim];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) continue;
+        task = q.tasks.front();
+        q.tasks.pop_front();
+        m_queued--;
+        m_steals++;
+        return true;
+    }
+    return false;
+}
+
+void TaskScheduler::execute(const Task& task)
+{
+    for (int i = task.begin; i < task.end; ++i) (*task.body)(i);
+    Group* group = task.group;
+    if (group->pending.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        group->finished = true;
+        group->done.notify_all();
+    }
+}
+
+void TaskScheduler::workerLoop(int index)
+{
+    t_scheduler = this;
+    t_queue = index;
+    Task task;
+    while (!m_stop) {
+        if (tryPop(index, task) || trySteal(index, task)) {
+            execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this] { return m_stop || m_queued.load() > 0; });
+    }
+}
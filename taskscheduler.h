@@ -0,0 +1,92 @@
+/*
+ * 文件名: taskscheduler.h
+ * 文件作用: 全局工作窃取任务调度器头文件
+ * 功能描述:
+ * 1. 固定数量的工作线程，每个线程持有一个双端任务队列: 本线程从队尾取任务 (后进先出，缓存友好)，
+ *    空闲线程从其他队列的队首窃取 (先进先出，窃取到的是较大、较早的任务)。
+ * 2. parallelFor 可以任意嵌套: 雅可比矩阵的扰动列 → 每条曲线的 (时间点 × Stehfest 项) →
+ *    Laplace 插值表/复反演求值点，内层任务直接压入当前线程的队列，由空闲线程窃取执行。
+ *    等待子任务完成的线程不阻塞，而是继续执行队列中的任务 (包括其他线程的任务)，
+ *    因此不会出现 QtConcurrent 嵌套 blockingMap 时工作线程互相等待、线程池被占满的情况。
+ * 3. 非工作线程 (界面线程、拟合线程) 调用时任务进入公共注入队列，调用线程只参与执行本组任务
+ *    (不会替其他外部线程或工作线程执行任务，避免被无关的长任务拖住)。
+ * 4. 任务体只捕获只读的共享数据与各自独立的输出位置，调度器本身不做任何同步之外的假设。
+ * 5. 等待中的线程连续多次取不到任务后在本组的条件变量上休眠，本组最后一个任务完成时唤醒，不再空转让出 CPU；
+ *    工作线程按短时限休眠，醒来后继续窃取新入队的任务。
+ */
+
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskScheduler
+{
+public:
+    // 全局调度器 (首次使用时创建，工作线程数 = 硬件线程数 - 1，调用线程补足最后一个)
+    static TaskScheduler& instance();
+
+    explicit TaskScheduler(int workers = 0);
+    ~TaskScheduler();
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * @brief 并行执行 body(i)，i = 0 .. count-1，全部完成后返回
+     * @param grain 每个任务连续处理的下标个数 (廉价任务取较大值以摊薄调度开销)
+     * 可在任务内部再次调用 (嵌套并行)，调用线程在等待期间执行其他任务。
+     */
+    void parallelFor(int count, const std::function<void(int)>& body, int grain = 1);
+
+    int workerCount() const { return (int)m_threads.size(); }
+
+    // 累计窃取次数 (诊断用)
+    long long stealCount() const { return m_steals.load(); }
+
+private:
+    struct Group
+    {
+        std::atomic<int> pending{0};
+        std::mutex mutex;
+        std::condition_variable done;
+        bool finished = false;      // 最后一个任务完成后在 mutex 下置位 (等待线程据此返回，之后 Group 即可析构)
+    };
+
+    struct Task
+    {
+        const std::function<void(int)>* body;
+        int begin;
+        int end;
+        Group* group;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(int index);
+    int currentQueue() const;
+    bool tryPop(int queue, Task& task);
+    bool tryPopGroup(int queue, const Group* group, Task& task);
+    bool trySteal(int self, Task& task);
+    void execute(const Task& task);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;  // [0, n) 为工作线程队列，[n] 为注入队列
+    std::vector<std::thread> m_threads;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<int> m_queued{0};
+    std::atomic<bool> m_stop{false};
+    std::atomic<long long> m_steals{0};
+};
+
+#endif // TASKSCHEDULER_H
@@ -0,0 +1,18 @@
+# ----------------------------------------------------
+# Project: bench_specialfunctions
+# Description: K0/K1/I0e/I1e 单点、批量版本与 boost::math 的耗时基准
+# ----------------------------------------------------
+
+TEMPLATE = app
+TARGET = bench_specialfunctions
+CONFIG += console c++17 release
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ../..
+
+# Boost 库 (对比基准)
+INCLUDEPATH += D:/08YYYXXX/boost_1_89_0
+
+SOURCES += \
+           bench_specialfunctions.cpp \
+           ../../specialfunctions.cpp
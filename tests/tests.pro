@@ -0,0 +1,10 @@
+# ----------------------------------------------------
+# Project: WellTest tests
+# Description: 数值内核的精度测试与性能基准 (独立于主工程构建)
+# ----------------------------------------------------
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+           tst_specialfunctions \
+           bench_specialfunctions
@@ -0,0 +1,122 @@
+/*
+ * 文件名: tst_specialfunctions.cpp
+ * 文件作用: SpecialFunctions 贝塞尔内核精度测试
+ * 功能描述:
+ * 1. 以 boost::math 为参考值，检查 K0、K1、I0e、I1e 的单点版本在 [1e-12, 700] 对数均匀网格上的相对误差。
+ * 2. 在区间切换点 (K 为 2，I 为 8) 两侧加密取点，覆盖小参数展开与大参数展开的衔接处。
+ * 3. 检查批量版本与单点版本逐位一致 (乱序混合区间输入、x <= 0 的奇点、负自变量)。
+ * 4. 任一检查失败时返回非零退出码。
+ */
+
+#include "specialfunctions.h"
+
+#include <boost/math/special_functions/bessel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 相对误差上限 (Chebyshev 系数截断到 1e-18 量级，误差主要来自舍入)
+const double Tolerance = 4e-15;
+
+int g_failures = 0;
+
+// 测试网格: 对数均匀点 + 切换点两侧的加密点
+std::vector<double> testGrid(double maxX, const std::vector<double>& switchPoints)
+{
+    std::vector<double> grid;
+    const int count = 20000;
+    double logMin = std::log(1e-12);
+    double logMax = std::log(maxX);
+    for (int i = 0; i < count; ++i) grid.push_back(std::exp(logMin + (logMax - logMin) * i / (count - 1)));
+    const double offsets[] = { 0.0, 1e-15, 1e-12, 1e-9, 1e-6, 1e-3, 1e-2, 5e-2 };
+    for (double s : switchPoints) {
+        for (double d : offsets) {
+            grid.push_back(s * (1.0 + d));
+            grid.push_back(s * (1.0 - d));
+        }
+        grid.push_back(std::nextafter(s, 0.0));
+        grid.push_back(std::nextafter(s, 1e300));
+        for (int i = 0; i <= 200; ++i) grid.push_back(s * (0.75 + 0.5 * i / 200.0));
+    }
+    std::sort(grid.begin(), grid.end());
+    return grid;
+}
+
+void checkAccuracy(const char* name, const std::vector<double>& grid,
+                   const std::function<double(double)>& tested, const std::function<double(double)>& reference)
+{
+    double maxError = 0.0;
+    double worstX = 0.0;
+    for (double x : grid) {
+        double ref = reference(x);
+        if (ref == 0.0 || !std::isfinite(ref)) continue;
+        double error = std::abs(tested(x) - ref) / std::abs(ref);
+        if (!(error <= maxError)) {
+            maxError = error;
+            worstX = x;
+        }
+    }
+    bool ok = maxError <= Tolerance;
+    if (!ok) g_failures++;
+    std::printf("%-4s %-6s 最大相对误差 %.3e (x = %.17g)\n", ok ? "通过" : "失败", name, maxError, worstX);
+}
+
+void checkBatch(const char* name, const std::vector<double>& input,
+                const std::function<double(double)>& scalar,
+                const std::function<void(const double*, double*, int)>& batch)
+{
+    std::vector<double> out(input.size());
+    batch(input.data(), out.data(), (int)input.size());
+    int mismatches = 0;
+    for (size_t i = 0; i < input.size(); ++i) {
+        double expected = scalar(input[i]);
+        if (std::memcmp(&expected, &out[i], sizeof(double)) != 0) mismatches++;
+    }
+    if (mismatches) g_failures++;
+    std::printf("%-4s %-6s 批量与单点逐位一致 (%d 个点，不一致 %d 个)\n", mismatches ? "失败" : "通过", name,
+                (int)input.size(), mismatches);
+}
+
+} // namespace
+
+int main()
+{
+    using boost::math::cyl_bessel_i;
+    using boost::math::cyl_bessel_k;
+
+    // 1. 单点精度: K 在 x > 700 后下溢，I 的缩放参考值在 700 以内可直接由 exp(-x)·I 计算
+    std::vector<double> kGrid = testGrid(700.0, { 2.0, 8.0 });
+    std::vector<double> iGrid = testGrid(700.0, { 2.0, 8.0 });
+    checkAccuracy("K0", kGrid, [](double x) { return SpecialFunctions::besselK0(x); },
+                  [](double x) { return cyl_bessel_k(0, x); });
+    checkAccuracy("K1", kGrid, [](double x) { return SpecialFunctions::besselK1(x); },
+                  [](double x) { return cyl_bessel_k(1, x); });
+    checkAccuracy("I0e", iGrid, [](double x) { return SpecialFunctions::besselI0e(x); },
+                  [](double x) { return std::exp(-x) * cyl_bessel_i(0, x); });
+    checkAccuracy("I1e", iGrid, [](double x) { return SpecialFunctions::besselI1e(x); },
+                  [](double x) { return std::exp(-x) * cyl_bessel_i(1, x); });
+    checkAccuracy("I1e(-x)", iGrid, [](double x) { return SpecialFunctions::besselI1e(-x); },
+                  [](double x) { return -std::exp(-x) * cyl_bessel_i(1, x); });
+
+    // 2. 批量版本: 乱序混合两个区间，含 x <= 0 与负自变量，长度跨越分组块大小
+    std::vector<double> mixed = kGrid;
+    mixed.push_back(0.0);
+    mixed.push_back(-1.0);
+    mixed.push_back(-9.0);
+    std::mt19937 rng(7);
+    std::shuffle(mixed.begin(), mixed.end(), rng);
+    checkBatch("K0", mixed, [](double x) { return SpecialFunctions::besselK0(x); }, SpecialFunctions::besselK0Batch);
+    checkBatch("K1", mixed, [](double x) { return SpecialFunctions::besselK1(x); }, SpecialFunctions::besselK1Batch);
+    checkBatch("I0e", mixed, [](double x) { return SpecialFunctions::besselI0e(x); }, SpecialFunctions::besselI0eBatch);
+    checkBatch("I1e", mixed, [](double x) { return SpecialFunctions::besselI1e(x); }, SpecialFunctions::besselI1eBatch);
+
+    std::printf(g_failures ? "共 %d 项检查失败\n" : "全部检查通过\n", g_failures);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,18 @@
+# ----------------------------------------------------
+# Project: tst_specialfunctions
+# Description: K0/K1/I0e/I1e Chebyshev 内核与 boost::math 的精度对比测试
+# ----------------------------------------------------
+
+TEMPLATE = app
+TARGET = tst_specialfunctions
+CONFIG += console c++17
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ../..
+
+# Boost 库 (仅作为参考值)
+INCLUDEPATH += D:/08YYYXXX/boost_1_89_0
+
+SOURCES += \
+           tst_specialfunctions.cpp \
+           ../../specialfunctions.cpp
@@ -8,6 +8,11 @@
  * 4. [修改] 移除了重置参数和更新上下限的按钮槽函数，相关功能移动至参数配置弹窗。
  * 5. [新增] 增加了拟合时间范围的自定义支持 (m_userDefinedTimeMax)。
  * 6. [新增] 支持 Model 19-36 的模型选择与切换逻辑。
+ * 7. [优化] 敏感性分析的多条曲线经 ModelManager 批量接口并行计算。
+ * 8. [优化] 滚轮调参改为后台流水线: 40 点预览 → 300 点完整曲线 → 悬停参数 ±1 步长的预先计算，新刻度作废旧任务。
+ * 9. [修改] 预先计算只在滚轮操作后进行 (不再响应悬停)，拟合进行中不做预先计算；被作废的任务经取消标志中止求解。
+ * 10. [新增] 左侧面板增加"多保真度拟合"开关 (代码创建)，开始拟合时传给 FittingCore，随项目保存。
+ * 11. [新增] 全局搜索选项 (开关、起点数、拉丁超立方/差分进化) 与候选解列表 (代码创建)，可将选中的候选写回参数表。
  */
 
 #include "wt_fittingwidget.h"
@@ -32,9 +37,14 @@
 #include <QHBoxLayout>
 #include <QPushButton>
 #include <QLabel>
+#include <QDialog>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QDialogButtonBox>
 #include <QBuffer>
 #include <QFileInfo>
 #include <QDateTime>
+#include <QtConcurrent>
 
 // 构造函数：初始化界面及相关变量
 FittingWidget::FittingWidget(QWidget *parent) :
@@ -54,7 +64,12 @@ FittingWidget::FittingWidget(QWidget *parent) :
     m_obsRawP(),
     m_isFitting(false),
     m_isCustomSamplingEnabled(false),
-    m_userDefinedTimeMax(-1.0)
+    m_userDefinedTimeMax(-1.0),
+    m_chkFidelityLadder(nullptr),
+    m_chkGlobalSearch(nullptr),
+    m_spinGlobalStarts(nullptr),
+    m_comboGlobalExploration(nullptr),
+    m_btnGlobalCandidates(nullptr)
 {
     ui->setupUi(this);
 
@@ -117,13 +132,12 @@ FittingWidget::FittingWidget(QWidget *parent) :
     // 4. 初始化参数表格管理器
     m_paramChart = new FittingParameterChart(ui->tableParams, this);
 
-    // 连接参数滚轮修改信号，实现滚动参数时实时刷新曲线
-    connect(m_paramChart, &FittingParameterChart::parameterChangedByWheel, this, [this](){
-        updateModelCurve(nullptr, false, false);
-    });
+    // 连接参数滚轮修改信号，实现滚动参数时实时刷新曲线 (后台预览 + 精算)
+    connect(m_paramChart, &FittingParameterChart::parameterChangedByWheel, this, &FittingWidget::onWheelParameterChanged);
 
     // 初始化绘图交互模式
     setupPlot();
+    setupFitOptions();
     m_chartManager->initializeCharts(m_plotLogLog, m_plotSemiLog, m_plotCartesian);
 
     // 注册元数据类型，以便在信号槽中传递复杂类型
@@ -146,9 +160,58 @@ FittingWidget::FittingWidget(QWidget *parent) :
     onSliderWeightChanged(50);
 }
 
+// 初始化拟合选项控件
+// 功能：.ui 中没有这些选项，在代码中创建并插入到"抽样设置"按钮之后
+void FittingWidget::setupFitOptions()
+{
+    m_chkFidelityLadder = new QCheckBox("多保真度拟合 (先粗后精)", this);
+    m_chkFidelityLadder->setToolTip("前期迭代使用较低的求解精度与较少的抽样点快速接近解，逐级提高至当前设置。\n"
+                                    "关闭后全程使用当前求解精度。");
+    m_chkFidelityLadder->setChecked(true);
+
+    // 全局搜索: 开关 + 起点数 + 探索方式，关闭时后两项不可编辑
+    m_chkGlobalSearch = new QCheckBox("全局搜索 (多起点)", this);
+    m_chkGlobalSearch->setToolTip("在拟合参数上下限内撒多个起点并行做局部拟合，最优候选再作为初值正常拟合。\n"
+                                  "适用于初值远离真解或误差曲面有多个极小值的情况，耗时约为起点数倍。");
+    m_spinGlobalStarts = new QSpinBox(this);
+    m_spinGlobalStarts->setRange(2, 64);
+    m_spinGlobalStarts->setValue(8);
+    m_spinGlobalStarts->setToolTip("起点数 (含当前参数)");
+    m_comboGlobalExploration = new QComboBox(this);
+    m_comboGlobalExploration->addItem("拉丁超立方", (int)FittingCore::LatinHypercube);
+    m_comboGlobalExploration->addItem("差分进化", (int)FittingCore::DifferentialEvolution);
+    m_comboGlobalExploration->setToolTip("拉丁超立方: 样本直接作为起点；差分进化: 以样本为初始种群进化若干代后取最优个体");
+    m_btnGlobalCandidates = new QPushButton("候选解...", this);
+    m_btnGlobalCandidates->setEnabled(false);
+    m_btnGlobalCandidates->setToolTip("查看最近一次全局搜索的候选解");
+
+    QHBoxLayout* globalLayout = new QHBoxLayout();
+    globalLayout->addWidget(new QLabel("起点", this));
+    globalLayout->addWidget(m_spinGlobalStarts);
+    globalLayout->addWidget(m_comboGlobalExploration, 1);
+    globalLayout->addWidget(m_btnGlobalCandidates);
+
+    auto updateGlobalControls = [this](bool enabled) {
+        m_spinGlobalStarts->setEnabled(enabled);
+        m_comboGlobalExploration->setEnabled(enabled);
+    };
+    connect(m_chkGlobalSearch, &QCheckBox::toggled, this, updateGlobalControls);
+    connect(m_btnGlobalCandidates, &QPushButton::clicked, this, &FittingWidget::onShowGlobalCandidates);
+    updateGlobalControls(false);
+
+    int index = ui->verticalLayout_Left->indexOf(ui->btnSamplingSettings);
+    ui->verticalLayout_Left->insertWidget(index + 1, m_chkFidelityLadder);
+    ui->verticalLayout_Left->insertWidget(index + 2, m_chkGlobalSearch);
+    ui->verticalLayout_Left->insertLayout(index + 3, globalLayout);
+}
+
 // 析构函数：释放 UI 资源
 FittingWidget::~FittingWidget()
 {
+    // 作废并等待后台滚轮任务结束
+    abortWheelRefresh();
+    abortSpeculation();
+    for (QFuture<void>& job : m_wheelJobs) job.waitForFinished();
     delete ui;
 }
 
@@ -458,13 +521,21 @@ void FittingWidget::on_btnRunFit_clicked() {
     }
     m_paramChart->updateParamsFromTable();
     m_isFitting = true;
+    // 预先计算与拟合争用同一调度器，拟合开始即中止
+    abortSpeculation();
     ui->btnRunFit->setEnabled(false);
     ui->btnSelectParams->setEnabled(false);
+    m_btnGlobalCandidates->setEnabled(false);
 
     ModelManager::ModelType modelType = m_currentModelType;
     QList<FitParameter> paramsCopy = m_paramChart->getParameters();
     double w = ui->sliderWeight->value() / 100.0;
-    if(m_core) m_core->startFit(modelType, paramsCopy, w);
+    if(m_core) {
+        m_core->setFidelityLadder(m_chkFidelityLadder->isChecked());
+        m_core->setGlobalSearch(m_chkGlobalSearch->isChecked(), m_spinGlobalStarts->value(),
+                                (FittingCore::GlobalExploration)m_comboGlobalExploration->currentData().toInt());
+        m_core->startFit(modelType, paramsCopy, w);
+    }
 }
 
 // 槽函数：停止拟合
@@ -504,6 +575,8 @@ void FittingWidget::on_btn_modelSelect_clicked() {
             // 切换参数管理器中的模型
             m_paramChart->switchModel(newType);
             m_currentModelType = newType;
+            // 候选解属于原模型，切换后不再可用
+            m_btnGlobalCandidates->setEnabled(false);
 
             // 更新按钮文本
             ui->btn_modelSelect->setText(ModelManager::getModelTypeName(newType));
@@ -540,6 +613,8 @@ void FittingWidget::loadProjectParams()
 // 核心函数：更新理论曲线
 // 功能：根据当前参数计算理论曲线，并支持敏感性分析模式
 void FittingWidget::updateModelCurve(const QMap<QString, double>* explicitParams, bool autoScale, bool calcError) {
+    // 同步刷新时作废尚未完成的滚轮预览/精算，避免旧结果覆盖
+    abortWheelRefresh();
     if(!m_modelManager) {
         QMessageBox::critical(this, "错误", "ModelManager 未初始化！");
         return;
@@ -563,42 +638,13 @@ void FittingWidget::updateModelCurve(const QMap<QString, double>* explicitParams
     if (explicitParams) {
         rawParams = *explicitParams;
     } else {
-        QList<FitParameter> allParams = m_paramChart->getParameters();
-        for(const auto& p : allParams) rawParams.insert(p.name, p.value);
-        QMap<QString, QString> rawTexts = m_paramChart->getRawParamTexts();
-        for(auto it = rawTexts.begin(); it != rawTexts.end(); ++it) {
-            QVector<double> vals = parseSensitivityValues(it.value());
-            if (!vals.isEmpty()) {
-                rawParams.insert(it.key(), vals.first());
-                if (vals.size() > 1 && sensitivityKey.isEmpty()) {
-                    sensitivityKey = it.key();
-                    sensitivityValues = vals;
-                }
-            } else { rawParams.insert(it.key(), 0.0); }
-        }
+        rawParams = collectTableParams(sensitivityKey, sensitivityValues);
     }
 
     // 预处理参数 (转换为求解器所需格式)
     QMap<QString, double> solverParams = FittingCore::preprocessParams(rawParams, m_currentModelType);
 
-    // [修改] 生成时间步长逻辑
-    QVector<double> targetT;
-
-    // 确定计算的最大时间
-    double tMax = 10000.0;
-    if (m_userDefinedTimeMax > 0) {
-        tMax = m_userDefinedTimeMax; // 优先使用用户设定值
-    } else if (!m_obsTime.isEmpty()) {
-        tMax = m_obsTime.last();
-    }
-
-    // 确定最小时间
-    double tMin = (!m_obsTime.isEmpty()) ? std::max(1e-5, m_obsTime.first()) : 1e-4;
-
-    // 如果用户设置的时间小于实测时间起始，修正范围防止错误
-    if (tMax < tMin) tMax = tMin * 10.0;
-
-    targetT = ModelManager::generateLogTimeSteps(300, log10(tMin), log10(tMax));
+    QVector<double> targetT = modelTimeSteps(300);
 
     bool isSensitivityMode = !sensitivityKey.isEmpty();
     ui->btnRunFit->setEnabled(!isSensitivityMode);
@@ -610,13 +656,18 @@ void FittingWidget::updateModelCurve(const QMap<QString, double>* explicitParams
         m_chartManager->plotAll(QVector<double>(), QVector<double>(), QVector<double>(), false, autoScale);
 
         QList<QColor> colors = { Qt::red, Qt::blue, QColor(0,180,0), Qt::magenta, QColor(255,140,0), Qt::cyan, Qt::darkRed, Qt::darkBlue };
-        for(int i = 0; i < sensitivityValues.size(); ++i) {
-            double val = sensitivityValues[i];
+        // 全部取值一次批量提交并行计算，再按顺序绘制
+        QVector<QMap<QString, double>> paramSets;
+        for(double val : sensitivityValues) {
             QMap<QString, double> currentParams = rawParams;
             currentParams[sensitivityKey] = val;
-            QMap<QString, double> currentSolverParams = FittingCore::preprocessParams(currentParams, m_currentModelType);
+            paramSets.append(FittingCore::preprocessParams(currentParams, m_currentModelType));
+        }
+        QVector<ModelCurveData> results = m_modelManager->calculateTheoreticalCurves(m_currentModelType, paramSets, targetT);
 
-            ModelCurveData res = m_modelManager->calculateTheoreticalCurve(m_currentModelType, currentSolverParams, targetT);
+        for(int i = 0; i < sensitivityValues.size(); ++i) {
+            double val = sensitivityValues[i];
+            const ModelCurveData& res = results[i];
             QColor c = colors[i % colors.size()];
             QString suffix = QString("%1=%2").arg(sensitivityKey).arg(val);
             QCPGraph* gP = m_plotLogLog->addGraph();
@@ -676,7 +727,76 @@ void FittingWidget::onFitFinished() {
     m_isFitting = false;
     ui->btnRunFit->setEnabled(true);
     ui->btnSelectParams->setEnabled(true);
-    QMessageBox::information(this, "完成", "拟合完成。");
+    int candidates = m_core ? m_core->lastGlobalCandidates().size() : 0;
+    m_btnGlobalCandidates->setEnabled(candidates > 0);
+    if (candidates > 0) {
+        QMessageBox::information(this, "完成", QString("拟合完成。全局搜索得到 %1 个候选解，可点击\"候选解...\"查看。").arg(candidates));
+    } else {
+        QMessageBox::information(this, "完成", "拟合完成。");
+    }
+}
+
+// 槽函数：显示全局搜索候选解
+// 功能：按均方误差升序列出候选解 (全局搜索保真度下的误差)，选中一行后可将其参数写回参数表
+void FittingWidget::onShowGlobalCandidates()
+{
+    if (!m_core) return;
+    QVector<FittingCore::GlobalCandidate> candidates = m_core->lastGlobalCandidates();
+    if (candidates.isEmpty()) return;
+
+    QList<FitParameter> params = m_paramChart->getParameters();
+    QList<FitParameter> fitted;
+    for (const FitParameter& p : params) {
+        if (p.isFit && p.name != "LfD") fitted.append(p);
+    }
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("全局搜索候选解");
+    dlg.resize(640, 360);
+    QVBoxLayout* layout = new QVBoxLayout(&dlg);
+
+    QTableWidget* table = new QTableWidget(candidates.size(), 4 + fitted.size(), &dlg);
+    QStringList headers;
+    headers << "序号" << "均方误差" << "迭代次数" << "状态";
+    for (const FitParameter& p : fitted) headers << (p.displayName.isEmpty() ? p.name : p.displayName);
+    table->setHorizontalHeaderLabels(headers);
+    table->verticalHeader()->setVisible(false);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setSelectionMode(QAbstractItemView::SingleSelection);
+    for (int row = 0; row < candidates.size(); ++row) {
+        const FittingCore::GlobalCandidate& c = candidates[row];
+        QString status = c.duplicate ? "重复" : (c.pruned ? "淘汰" : "");
+        table->setItem(row, 0, new QTableWidgetItem(QString::number(row + 1)));
+        table->setItem(row, 1, new QTableWidgetItem(QString::number(c.mse, 'g', 6)));
+        table->setItem(row, 2, new QTableWidgetItem(QString::number(c.iterations)));
+        table->setItem(row, 3, new QTableWidgetItem(status));
+        for (int j = 0; j < fitted.size(); ++j) {
+            table->setItem(row, 4 + j, new QTableWidgetItem(QString::number(c.params.value(fitted[j].name), 'g', 6)));
+        }
+    }
+    table->resizeColumnsToContents();
+    table->selectRow(0);
+    layout->addWidget(table);
+
+    QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Close, &dlg);
+    QPushButton* btnApply = buttons->addButton("应用所选候选", QDialogButtonBox::AcceptRole);
+    btnApply->setEnabled(!m_isFitting);
+    connect(buttons, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+    layout->addWidget(buttons);
+
+    if (dlg.exec() != QDialog::Accepted || m_isFitting) return;
+    int row = table->currentRow();
+    if (row < 0 || row >= candidates.size()) return;
+
+    // 只写回被拟合的参数，其余参数保持参数表中的当前值
+    const QMap<QString, double>& chosen = candidates[row].params;
+    for (FitParameter& p : params) {
+        if (p.isFit && chosen.contains(p.name)) p.value = chosen.value(p.name);
+    }
+    m_paramChart->setParameters(params);
+    updateModelCurve(nullptr, false);
 }
 
 // 槽函数：导出拟合参数
@@ -910,6 +1030,10 @@ QJsonObject FittingWidget::getJsonState() const
         intervalArr.append(obj);
     }
     root["customIntervals"] = intervalArr;
+    root["useFidelityLadder"] = m_chkFidelityLadder->isChecked();
+    root["useGlobalSearch"] = m_chkGlobalSearch->isChecked();
+    root["globalStarts"] = m_spinGlobalStarts->value();
+    root["globalExploration"] = m_comboGlobalExploration->currentData().toInt();
 
     // 保存手动拟合结果
     if (m_chartManager) {
@@ -930,6 +1054,7 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
     if (root.contains("modelType")) {
         int type = root["modelType"].toInt();
         m_currentModelType = (ModelManager::ModelType)type;
+        m_btnGlobalCandidates->setEnabled(false);
 
         // [修改] 只显示模型名称，去除 "当前: "
         ui->btn_modelSelect->setText(ModelManager::getModelTypeName(m_currentModelType));
@@ -1019,6 +1144,11 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
         }
         if(m_core) m_core->setSamplingSettings(m_customIntervals, m_isCustomSamplingEnabled);
     }
+    m_chkFidelityLadder->setChecked(root.value("useFidelityLadder").toBool(true));
+    m_chkGlobalSearch->setChecked(root.value("useGlobalSearch").toBool(false));
+    m_spinGlobalStarts->setValue(root.value("globalStarts").toInt(8));
+    int exploration = m_comboGlobalExploration->findData(root.value("globalExploration").toInt((int)FittingCore::LatinHypercube));
+    m_comboGlobalExploration->setCurrentIndex(qMax(0, exploration));
 
     // [新增] 加载用户自定义的拟合时间范围
     if (root.contains("fittingTimeMax")) {
@@ -1066,6 +1196,170 @@ void FittingWidget::loadFittingState(const QJsonObject& root)
     }
 }
 
+// 辅助函数：从参数表收集参数
+// 功能：数值列文本优先 (支持逗号分隔的敏感性输入，取第一个值)；overrideName 非空时以 overrideText 代替该参数的单元格文本
+QMap<QString, double> FittingWidget::collectTableParams(QString& sensitivityKey, QVector<double>& sensitivityValues,
+                                                        const QString& overrideName, const QString& overrideText) {
+    QMap<QString, double> rawParams;
+    QList<FitParameter> allParams = m_paramChart->getParameters();
+    for(const auto& p : allParams) rawParams.insert(p.name, p.value);
+    QMap<QString, QString> rawTexts = m_paramChart->getRawParamTexts();
+    if (!overrideName.isEmpty()) rawTexts[overrideName] = overrideText;
+    for(auto it = rawTexts.begin(); it != rawTexts.end(); ++it) {
+        QVector<double> vals = parseSensitivityValues(it.value());
+        if (!vals.isEmpty()) {
+            rawParams.insert(it.key(), vals.first());
+            if (vals.size() > 1 && sensitivityKey.isEmpty()) {
+                sensitivityKey = it.key();
+                sensitivityValues = vals;
+            }
+        } else { rawParams.insert(it.key(), 0.0); }
+    }
+    return rawParams;
+}
+
+// 辅助函数：生成理论曲线的对数时间步长 (范围取自用户设定时间或实测数据)
+QVector<double> FittingWidget::modelTimeSteps(int count) const {
+    // 确定计算的最大时间
+    double tMax = 10000.0;
+    if (m_userDefinedTimeMax > 0) {
+        tMax = m_userDefinedTimeMax; // 优先使用用户设定值
+    } else if (!m_obsTime.isEmpty()) {
+        tMax = m_obsTime.last();
+    }
+
+    // 确定最小时间
+    double tMin = (!m_obsTime.isEmpty()) ? std::max(1e-5, m_obsTime.first()) : 1e-4;
+
+    // 如果用户设置的时间小于实测时间起始，修正范围防止错误
+    if (tMax < tMin) tMax = tMin * 10.0;
+
+    return ModelManager::generateLogTimeSteps(count, log10(tMin), log10(tMax));
+}
+
+// 槽函数：滚轮调参后的交互刷新
+// 功能：后台先算 40 点低阶预览并立即绘制，再算完整 300 点曲线原位替换，
+//       最后预先计算所滚动参数 ±1 个步长的曲线 (写入求解器的无因次曲线缓存，下一格滚动直接命中；拟合进行中跳过)；
+//       新的滚轮刻度到达时置位旧任务的取消标志，进行中的求解随即中止
+void FittingWidget::onWheelParameterChanged() {
+    if (!m_modelManager) return;
+
+    // 无时间参考或存在敏感性输入时沿用同步刷新
+    QString sensitivityKey;
+    QVector<double> sensitivityValues;
+    QMap<QString, double> rawParams = collectTableParams(sensitivityKey, sensitivityValues);
+    if ((m_obsTime.isEmpty() && m_userDefinedTimeMax <= 0) || !sensitivityKey.isEmpty()) {
+        updateModelCurve(nullptr, false, false);
+        return;
+    }
+    ui->btnRunFit->setEnabled(true);
+
+    abortWheelRefresh();
+    abortSpeculation();
+
+    // 曲线缓存按完全一致命中复用 (batchCurveParams)，预先计算的结果才能被下一格滚动读取
+    WheelJob job;
+    job.type = m_currentModelType;
+    job.params = ModelManager::batchCurveParams(FittingCore::preprocessParams(rawParams, m_currentModelType));
+    job.time = modelTimeSteps(FullCurvePoints);
+    job.previewTime = modelTimeSteps(PreviewCurvePoints);
+    if (!m_isFitting) job.neighbours = speculativeParams();
+    job.cancel = std::make_shared<std::atomic<bool>>(false);
+    job.speculationCancel = std::make_shared<std::atomic<bool>>(false);
+    m_wheelCancel = job.cancel;
+    m_speculationCancel = job.speculationCancel;
+
+    int generation = m_wheelGeneration.load();
+    int speculation = m_speculationGeneration.load();
+    m_wheelJobs.append(QtConcurrent::run([this, job, generation, speculation]() {
+        executeWheelJob(job, generation, speculation);
+    }));
+    pruneWheelJobs();
+}
+
+// 辅助函数：作废进行中的滚轮预览/精算 (已投递的结果按任务编号丢弃，求解按取消标志中止)
+void FittingWidget::abortWheelRefresh() {
+    m_wheelGeneration++;
+    if (m_wheelCancel) {
+        m_wheelCancel->store(true);
+        m_wheelCancel.reset();
+    }
+}
+
+// 辅助函数：作废进行中的预先计算
+void FittingWidget::abortSpeculation() {
+    m_speculationGeneration++;
+    if (m_speculationCancel) {
+        m_speculationCancel->store(true);
+        m_speculationCancel.reset();
+    }
+}
+
+// 辅助函数：最近滚动参数 ±1 个滚轮步长对应的求解器参数 (敏感性输入时为空)
+QVector<QMap<QString, double>> FittingWidget::speculativeParams() {
+    QVector<QMap<QString, double>> sets;
+    QString name, lowerText, upperText;
+    if (!m_paramChart->wheelNeighbours(name, lowerText, upperText)) return sets;
+    for (const QString& text : { lowerText, upperText }) {
+        QString sensitivityKey;
+        QVector<double> sensitivityValues;
+        QMap<QString, double> rawParams = collectTableParams(sensitivityKey, sensitivityValues, name, text);
+        if (!sensitivityKey.isEmpty()) return QVector<QMap<QString, double>>();
+        sets.append(ModelManager::batchCurveParams(FittingCore::preprocessParams(rawParams, m_currentModelType)));
+    }
+    return sets;
+}
+
+// 后台执行滚轮刷新任务: 预览 → 精算 → 预先计算
+void FittingWidget::executeWheelJob(const WheelJob& job, int generation, int speculation) {
+    auto stale = [this, generation, &job]() { return job.cancel->load() || m_wheelGeneration.load() != generation; };
+    auto speculationStale = [this, speculation, &job]() {
+        return job.speculationCancel->load() || m_speculationGeneration.load() != speculation;
+    };
+    auto postCurve = [this, generation](const ModelCurveData& curve) {
+        QMetaObject::invokeMethod(this, [this, generation, curve]() {
+            if (generation != m_wheelGeneration.load()) return;
+            m_chartManager->plotAll(std::get<0>(curve), std::get<1>(curve), std::get<2>(curve), true, false);
+            if(m_plotLogLog) m_plotLogLog->replot();
+            if(m_plotSemiLog) m_plotSemiLog->replot();
+            if(m_plotCartesian) m_plotCartesian->replot();
+        }, Qt::QueuedConnection);
+    };
+
+    // 1. 预览: 低阶 Stehfest、少量时间点
+    QMap<QString, double> previewParams = job.params;
+    previewParams["N"] = 4.0;
+    ModelCurveData preview = m_modelManager->calculateTheoreticalCurve(job.type, previewParams, job.previewTime, job.cancel.get());
+    if (stale()) return;
+    postCurve(preview);
+
+    // 2. 完整曲线
+    ModelCurveData full = m_modelManager->calculateTheoreticalCurve(job.type, job.params, job.time, job.cancel.get());
+    if (stale()) return;
+    postCurve(full);
+
+    // 3. 预先计算相邻步长的预览与完整曲线 (结果只为写入曲线缓存，不绘制)
+    if (job.neighbours.isEmpty() || speculationStale()) return;
+    QVector<ModelManager::CurveRequest> requests;
+    for (const auto& params : job.neighbours) {
+        QMap<QString, double> previewParams = params;
+        previewParams["N"] = 4.0;
+        requests.append(ModelManager::CurveRequest{ job.type, previewParams, job.previewTime });
+        requests.append(ModelManager::CurveRequest{ job.type, params, job.time });
+    }
+    for (const auto& request : requests) {
+        if (speculationStale()) return;
+        m_modelManager->calculateTheoreticalCurve(request.type, request.params, request.time, job.speculationCancel.get());
+    }
+}
+
+// 辅助函数：清理已结束的后台滚轮任务
+void FittingWidget::pruneWheelJobs() {
+    for (int i = m_wheelJobs.size() - 1; i >= 0; --i) {
+        if (m_wheelJobs[i].isFinished()) m_wheelJobs.removeAt(i);
+    }
+}
+
 // 辅助函数：解析敏感性分析输入
 QVector<double> FittingWidget::parseSensitivityValues(const QString& text) {
     QVector<double> values;
@@ -1,6 +1,9 @@
 /*
  * 文件名: wt_fittingwidget.h
  * 修改说明: 删除了已移除按钮的槽函数声明，调整了变量顺序以消除警告。
+ * 滚轮刷新任务携带取消标志，预先计算只在滚轮操作后进行，拟合期间不做预先计算。
+ * 拟合选项 (多保真度开关) 在代码中创建，插入抽样设置按钮之后。
+ * 全局搜索选项 (开关、起点数、探索方式) 与候选解列表同样在代码中创建。
  */
 
 #ifndef WT_FITTINGWIDGET_H
@@ -14,6 +17,13 @@
 #include <QMdiSubWindow>
 #include <QResizeEvent>
 #include <QShowEvent>
+#include <QCheckBox>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QPushButton>
+#include <QFuture>
+#include <atomic>
+#include <memory>
 
 #include "modelmanager.h"
 #include "fittingparameterchart.h"
@@ -81,6 +91,12 @@ private slots:
     // 响应半对数直线移动
     void onSemiLogLineMoved(double k, double b);
 
+    // 滚轮调参后的交互刷新 (后台预览 + 精算 + 相邻步长预先计算)
+    void onWheelParameterChanged();
+
+    // 显示最近一次全局搜索的候选解，可将选中的候选写回参数表
+    void onShowGlobalCandidates();
+
 private:
     Ui::FittingWidget *ui;
     ModelManager* m_modelManager;
@@ -117,7 +133,43 @@ private:
 
     QList<SamplingInterval> m_customIntervals;
 
+    // 拟合选项控件 (代码创建，不在 .ui 中)
+    QCheckBox* m_chkFidelityLadder;                   // 多保真度拟合: 前期迭代用低精度求解器与较少抽样点
+    QCheckBox* m_chkGlobalSearch;                     // 全局搜索: 多起点局部拟合后取最优候选
+    QSpinBox* m_spinGlobalStarts;                     // 全局搜索起点数
+    QComboBox* m_comboGlobalExploration;              // 探索方式 (下标与 FittingCore::GlobalExploration 一致)
+    QPushButton* m_btnGlobalCandidates;               // 查看候选解 (有候选时可用)
+
+    // 滚轮交互刷新任务的输入 (在界面线程收集，按值交给后台线程)
+    struct WheelJob {
+        ModelManager::ModelType type;
+        QMap<QString, double> params;                 // 当前参数 (已预处理)
+        QVector<double> time;                         // 完整曲线时间点
+        QVector<double> previewTime;                  // 预览曲线时间点
+        QVector<QMap<QString, double>> neighbours;    // 滚动参数 ±1 步长的参数 (拟合进行中为空)
+        std::shared_ptr<std::atomic<bool>> cancel;            // 预览/精算的取消标志
+        std::shared_ptr<std::atomic<bool>> speculationCancel; // 预先计算的取消标志
+    };
+    static const int PreviewCurvePoints = 40;
+    static const int FullCurvePoints = 300;
+
+    std::atomic<int> m_wheelGeneration{0};            // 递增即作废之前的预览/精算
+    std::atomic<int> m_speculationGeneration{0};      // 递增即作废之前的预先计算
+    std::shared_ptr<std::atomic<bool>> m_wheelCancel;       // 进行中预览/精算的取消标志
+    std::shared_ptr<std::atomic<bool>> m_speculationCancel; // 进行中预先计算的取消标志
+    QList<QFuture<void>> m_wheelJobs;
+
+    void executeWheelJob(const WheelJob& job, int generation, int speculation);
+    void abortWheelRefresh();
+    void abortSpeculation();
+    void pruneWheelJobs();
+    QVector<QMap<QString, double>> speculativeParams();
+    QMap<QString, double> collectTableParams(QString& sensitivityKey, QVector<double>& sensitivityValues,
+                                             const QString& overrideName = QString(), const QString& overrideText = QString());
+    QVector<double> modelTimeSteps(int count) const;
+
     void setupPlot();
+    void setupFitOptions();
     void initializeDefaultModel();
     QVector<double> parseSensitivityValues(const QString& text);
     void hideUnwantedParams();
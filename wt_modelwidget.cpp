@@ -5,12 +5,18 @@
  * 1. 界面初始化：根据模型类型动态调整参数输入框的显示/隐藏 (如内/外区参数)。
  * 2. 求解器集成：根据 ID 范围 (0-17 或 18-35) 实例化并调用对应的数学模型。
  * 3. 业务逻辑：处理计算请求、参数敏感性分析、结果绘图与导出。
+ * 4. 敏感性分析的多组参数一次批量提交并行计算。
+ * 5. 计算在后台线程进行: 先以低阶 Stehfest、少量时间点给出预览曲线，再精算并原位替换，
+ *    按钮显示进度；计算中编辑任一参数即作废当前计算。
+ * 6. 作废计算时置位任务的取消标志，求解器在 Stehfest 求值点之间检查并提前退出；已绘制的预览曲线随之清除。
+ * 7. 高精度开关只决定本界面计算使用的 Stehfest 阶数 (写入参数字典)，不再转发给求解器。
  */
 
 #include "wt_modelwidget.h"
 #include "ui_wt_modelwidget.h"
 #include "modelmanager.h"
 #include "modelparameter.h"
+#include "dimensionlesscurvecache.h"
 
 #include <QDebug>
 #include <QMessageBox>
@@ -22,6 +28,7 @@
 #include <QLabel>
 #include <QLineEdit>
 #include <QGridLayout>
+#include <QtConcurrent>
 #include <cmath>
 
 WT_ModelWidget::WT_ModelWidget(ModelType type, QWidget *parent)
@@ -31,6 +38,8 @@ WT_ModelWidget::WT_ModelWidget(ModelType type, QWidget *parent)
     , m_solver1(nullptr)
     , m_solver2(nullptr)
     , m_highPrecision(true)
+    , m_running(false)
+    , m_generation(0)
 {
     ui->setupUi(this);
 
@@ -65,6 +74,10 @@ WT_ModelWidget::WT_ModelWidget(ModelType type, QWidget *parent)
 
 WT_ModelWidget::~WT_ModelWidget()
 {
+    // 作废并取消后台计算 (求解器在下一个 Laplace 求值点即退出)，等待结束后再释放求解器
+    m_generation++;
+    if (m_cancel) m_cancel->store(true);
+    for (QFuture<void>& job : m_jobs) job.waitForFinished();
     if(m_solver1) delete m_solver1;
     if(m_solver2) delete m_solver2;
     delete ui;
@@ -77,13 +90,14 @@ QString WT_ModelWidget::getModelName() const {
 }
 
 // 转发给 Solver 进行计算
-WT_ModelWidget::ModelCurveData WT_ModelWidget::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime)
+WT_ModelWidget::ModelCurveData WT_ModelWidget::calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime,
+                                                                         const std::atomic<bool>* cancel)
 {
     if (m_solver1) {
-        return m_solver1->calculateTheoreticalCurve(params, providedTime);
+        return m_solver1->calculateTheoreticalCurve(params, providedTime, cancel);
     }
     if (m_solver2) {
-        return m_solver2->calculateTheoreticalCurve(params, providedTime);
+        return m_solver2->calculateTheoreticalCurve(params, providedTime, cancel);
     }
     return ModelCurveData();
 }
@@ -91,8 +105,6 @@ WT_ModelWidget::ModelCurveData WT_ModelWidget::calculateTheoreticalCurve(const Q
 void WT_ModelWidget::setHighPrecision(bool high)
 {
     m_highPrecision = high;
-    if (m_solver1) m_solver1->setHighPrecision(high);
-    if (m_solver2) m_solver2->setHighPrecision(high);
 }
 
 void WT_ModelWidget::initUi() {
@@ -234,6 +246,11 @@ void WT_ModelWidget::setupConnections() {
 
     connect(ui->checkShowPoints, &QCheckBox::toggled, this, &WT_ModelWidget::onShowPointsToggled);
 
+    // 计算过程中编辑任一参数即取消当前计算
+    for (QLineEdit* edit : findChildren<QLineEdit*>()) {
+        connect(edit, &QLineEdit::textEdited, this, &WT_ModelWidget::onParameterEdited);
+    }
+
     // 转发模型选择按钮信号
     connect(ui->btnSelectModel, &QPushButton::clicked, this, &WT_ModelWidget::requestModelSelection);
 }
@@ -318,12 +335,40 @@ void WT_ModelWidget::onShowPointsToggled(bool checked) {
 }
 
 void WT_ModelWidget::onCalculateClicked() {
+    // 上一次计算仍在进行时先作废 (其后续结果不再绘制)
+    cancelCalculation();
     ui->calculateButton->setEnabled(false);
     ui->calculateButton->setText("计算中...");
-    QCoreApplication::processEvents();
     runCalculation();
+}
+
+void WT_ModelWidget::onParameterEdited() {
+    // 计算过程中修改参数: 当前结果已过期，取消计算并恢复按钮
+    if (m_running) cancelCalculation();
+}
+
+void WT_ModelWidget::cancelCalculation() {
+    m_generation++;
+    // 置位上一任务的取消标志: 进行中的求解在下一个 Laplace 求值点即退出
+    if (m_cancel) {
+        m_cancel->store(true);
+        m_cancel.reset();
+    }
+    // 作废任务的预览/部分曲线不再保留在图上
+    if (m_running) {
+        MouseZoom* plot = ui->chartWidget->getPlot();
+        plot->clearGraphs();
+        plot->replot();
+        m_curves.clear();
+    }
+    m_running = false;
     ui->calculateButton->setEnabled(true);
     ui->calculateButton->setText("开始计算");
+
+    // 清理已结束的后台任务
+    for (int i = m_jobs.size() - 1; i >= 0; --i) {
+        if (m_jobs[i].isFinished()) m_jobs.removeAt(i);
+    }
 }
 
 void WT_ModelWidget::runCalculation() {
@@ -430,48 +475,133 @@ void WT_ModelWidget::runCalculation() {
     QString resultTextHeader = QString("计算完成 (%1)\n").arg(getModelName());
     if(isSensitivity) resultTextHeader += QString("敏感性参数: %1\n").arg(sensitivityKey);
 
-    // 循环计算
+    // 构建各组参数
+    CalculationJob job;
+    job.time = t;
+    job.coarseTime = ModelManager::generateLogTimeSteps(qMin(nPoints, CoarsePoints), -3.0, log10(maxTime));
+    job.header = resultTextHeader;
+    job.baseParams = baseParams;
+    job.cancel = std::make_shared<std::atomic<bool>>(false);
+    m_cancel = job.cancel;
     for(int i = 0; i < iterations; ++i) {
         QMap<QString, double> currentParams = baseParams;
-        double val = 0;
         if (isSensitivity) {
-            val = sensitivityValues[i];
-            currentParams[sensitivityKey] = val;
+            currentParams[sensitivityKey] = sensitivityValues[i];
 
             if (sensitivityKey == "L" || sensitivityKey == "Lf") {
                 if(currentParams["L"] > 1e-9) currentParams["LfD"] = currentParams["Lf"] / currentParams["L"];
             }
         }
+        job.paramSets.append(currentParams);
+    }
+    // 已是低阶、少点时预览与精算相同，只做一遍
+    job.preview = (baseParams["N"] > 4.0 || nPoints > CoarsePoints);
 
-        ModelCurveData res = calculateTheoreticalCurve(currentParams, t);
-
-        res_tD = std::get<0>(res);
-        res_pD = std::get<1>(res);
-        res_dpD = std::get<2>(res);
-
+    // 先按顺序建立空曲线 (每条曲线占压力、导数两个图层)，计算结果到达后原位更新数据
+    for(int i = 0; i < iterations; ++i) {
+        double val = isSensitivity ? sensitivityValues[i] : 0.0;
         QColor curveColor = isSensitivity ? m_colorList[i] : Qt::red;
         QString legendName;
         if (isSensitivity) legendName = QString("%1 = %2").arg(sensitivityKey).arg(val);
         else legendName = "理论曲线";
 
-        plotCurve(res, legendName, curveColor, isSensitivity);
+        plotCurve(ModelCurveData(), legendName, curveColor, isSensitivity);
+    }
+    onShowPointsToggled(ui->checkShowPoints->isChecked());
+
+    // 后台计算: 界面线程不再阻塞
+    m_curves = QVector<ModelCurveData>(iterations);
+    m_running = true;
+    int generation = m_generation.load();
+    m_jobs.append(QtConcurrent::run([this, job, generation]() { executeCalculation(job, generation); }));
+}
+
+void WT_ModelWidget::executeCalculation(const CalculationJob& job, int generation) {
+    // 在后台线程执行: 预览 (低阶 Stehfest、少量时间点) → 精算 (界面设定的阶数与点数)，
+    // 每条曲线完成即投递到界面线程原位刷新；作废后尚未开始的曲线直接跳过
+    const std::atomic<bool>* cancel = job.cancel.get();
+    auto cancelled = [this, generation, cancel]() { return cancel->load() || m_generation.load() != generation; };
+    int count = job.paramSets.size();
+    int stages = job.preview ? 2 : 1;
+    std::atomic<int> finished(0);
+
+    for (int stage = 0; stage < stages; ++stage) {
+        if (cancelled()) return;
+        bool coarse = job.preview && stage == 0;
+        QVector<QMap<QString, double>> sets = job.paramSets;
+        QVector<QString> shareKeys;
+        for (auto& params : sets) {
+            params = ModelManager::batchCurveParams(params);
+            if (coarse) params["N"] = 4.0;
+            shareKeys.append(DimensionlessCurveCache::shapeKey(params));
+        }
+        const QVector<double>& t = coarse ? job.coarseTime : job.time;
+
+        ModelManager::scheduleCurveBatch(shareKeys, [&](int i) {
+            if (cancelled()) return ModelCurveData();
+            return calculateTheoreticalCurve(sets[i], t, cancel);
+        }, [&](int i, const ModelCurveData& curve) {
+            if (cancelled()) return;
+            int done = ++finished;
+            bool refined = !coarse;
+            QMetaObject::invokeMethod(this, [this, generation, i, curve, done, refined, stages, count]() {
+                onCurveReady(generation, i, curve, refined, done, stages * count);
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    if (cancelled()) return;
+    QMetaObject::invokeMethod(this, [this, generation, job]() {
+        onCalculationFinished(generation, job);
+    }, Qt::QueuedConnection);
+}
+
+void WT_ModelWidget::onCurveReady(int generation, int index, const ModelCurveData& curve, bool refined, int done, int total) {
+    if (generation != m_generation.load()) return;
+
+    MouseZoom* plot = ui->chartWidget->getPlot();
+    if (2 * index + 1 >= plot->graphCount()) return;
+    plot->graph(2 * index)->setData(std::get<0>(curve), std::get<1>(curve));
+    plot->graph(2 * index + 1)->setData(std::get<0>(curve), std::get<2>(curve));
+
+    if (refined && index < m_curves.size()) m_curves[index] = curve;
+
+    plot->rescaleAxes();
+    if(plot->xAxis->range().lower <= 0) plot->xAxis->setRangeLower(1e-3);
+    if(plot->yAxis->range().lower <= 0) plot->yAxis->setRangeLower(1e-3);
+    plot->replot();
+
+    ui->calculateButton->setText(QString("%1 %2/%3").arg(refined ? "精算中" : "预览中").arg(done).arg(total));
+}
+
+void WT_ModelWidget::onCalculationFinished(int generation, const CalculationJob& job) {
+    if (generation != m_generation.load()) return;
+    m_running = false;
+
+    // 结果表与导出数据取最后一条曲线 (与原逐条计算时的行为一致)
+    if (!m_curves.isEmpty()) {
+        res_tD = std::get<0>(m_curves.last());
+        res_pD = std::get<1>(m_curves.last());
+        res_dpD = std::get<2>(m_curves.last());
     }
 
     // 更新结果
-    QString resultText = resultTextHeader;
+    QString resultText = job.header;
     resultText += "t(h)\t\tDp(MPa)\t\tdDp(MPa)\n";
     for(int i=0; i<res_pD.size(); ++i) {
         resultText += QString("%1\t%2\t%3\n").arg(res_tD[i],0,'e',4).arg(res_pD[i],0,'e',4).arg(res_dpD[i],0,'e',4);
     }
     ui->resultTextEdit->setText(resultText);
 
-    ui->chartWidget->getPlot()->rescaleAxes();
+    MouseZoom* plot = ui->chartWidget->getPlot();
+    plot->rescaleAxes();
     if(plot->xAxis->range().lower <= 0) plot->xAxis->setRangeLower(1e-3);
     if(plot->yAxis->range().lower <= 0) plot->yAxis->setRangeLower(1e-3);
     plot->replot();
 
-    onShowPointsToggled(ui->checkShowPoints->isChecked());
-    emit calculationCompleted(getModelName(), baseParams);
+    ui->calculateButton->setEnabled(true);
+    ui->calculateButton->setText("开始计算");
+    emit calculationCompleted(getModelName(), job.baseParams);
 }
 
 void WT_ModelWidget::plotCurve(const ModelCurveData& data, const QString& name, QColor color, bool isSensitivity) {
@@ -5,6 +5,8 @@
  * 1. 管理用户界面，处理参数输入、按钮响应和图表展示。
  * 2. 包含两个可能的求解器指针 (m_solver1, m_solver2)，根据模型 ID 动态实例化。
  * 3. 继承自 QWidget，负责具体的业务交互逻辑。
+ * 4. 理论曲线在后台分预览/精算两阶段计算，逐条回到界面线程刷新，可随参数编辑取消。
+ * 5. 计算任务携带取消标志，作废后进行中的求解提前退出，并清除已绘制的预览曲线。
  */
 
 #ifndef WT_MODELWIDGET_H
@@ -15,6 +17,9 @@
 #include <QVector>
 #include <QColor>
 #include <tuple>
+#include <atomic>
+#include <memory>
+#include <QFuture>
 #include "chartwidget.h"
 #include "modelsolver01-06.h"
 #include "modelsolver19_36.h" // [新增]
@@ -40,7 +45,8 @@ public:
     void setHighPrecision(bool high);
 
     // 直接调用求解器计算（供外部管理器使用，非 UI 交互）
-    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>());
+    ModelCurveData calculateTheoreticalCurve(const QMap<QString, double>& params, const QVector<double>& providedTime = QVector<double>(),
+                                             const std::atomic<bool>* cancel = nullptr);
 
     // 获取当前模型名称
     QString getModelName() const;
@@ -59,6 +65,9 @@ public slots:
     // [逻辑] 响应 L 或 Lf 变化，自动更新 LfD
     void onDependentParamsChanged();
 
+    // 计算过程中参数被编辑: 取消当前计算
+    void onParameterEdited();
+
     void onShowPointsToggled(bool checked);
     void onExportData();
 
@@ -66,7 +75,24 @@ private:
     void initUi();
     void initChart();
     void setupConnections();
-    void runCalculation(); // UI 触发的计算流程封装
+    void runCalculation(); // UI 触发的计算流程封装 (收集参数后提交后台任务)
+
+    // 一次计算任务的输入 (在界面线程收集，按值交给后台线程)
+    struct CalculationJob {
+        QVector<QMap<QString, double>> paramSets; // 每条曲线的参数
+        QVector<double> time;                     // 精算时间点
+        QVector<double> coarseTime;               // 预览时间点
+        bool preview = false;                     // 是否先计算预览曲线
+        QString header;                           // 结果表表头
+        QMap<QString, double> baseParams;         // 完成信号携带的基础参数
+        std::shared_ptr<std::atomic<bool>> cancel; // 取消标志: 作废时置位，求解器在 Laplace 求值之间检查
+    };
+    static const int CoarsePoints = 25;           // 预览曲线的时间点数
+
+    void cancelCalculation();
+    void executeCalculation(const CalculationJob& job, int generation);
+    void onCurveReady(int generation, int index, const ModelCurveData& curve, bool refined, int done, int total);
+    void onCalculationFinished(int generation, const CalculationJob& job);
 
     // 辅助函数
     QVector<double> parseInput(const QString& text);
@@ -86,6 +112,13 @@ private:
     bool m_highPrecision;
     QList<QColor> m_colorList;
 
+    // 后台计算状态: 任务编号递增即作废之前的任务，同时置位其取消标志让进行中的求解尽快退出
+    bool m_running;
+    std::atomic<int> m_generation;
+    std::shared_ptr<std::atomic<bool>> m_cancel;
+    QList<QFuture<void>> m_jobs;
+    QVector<ModelCurveData> m_curves; // 本次精算结果 (按曲线顺序)
+
     // 缓存计算结果
     QVector<double> res_tD;
     QVector<double> res_pD;